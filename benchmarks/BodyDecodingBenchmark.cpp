@@ -0,0 +1,74 @@
+// CPU time to turn a request body into a domain object. The baseline is what the controllers did
+// before: accept() to validate, parse() into a DOM, then from_json into the domain type.
+
+#include <chrono>
+#include <print>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "domain/JsonDecoder.hpp"
+#include "domain/Utilities.hpp"
+
+namespace {
+    constexpr size_t Iterations = 200000;
+
+    template<typename Work>
+    double NanosPerCall(Work work) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < Iterations; i++) {
+            work();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / Iterations;
+    }
+
+    std::string GroupBody(const size_t teams) {
+        nlohmann::json body = {{"name", "Group A"}, {"tournamentId", "5a0c7c1e-5d3f-4a36-9f63-2a3e1c5b7d10"}};
+        body["teams"] = nlohmann::json::array();
+        for (size_t i = 0; i < teams; i++) {
+            body["teams"].push_back({{"id", std::format("5a0c7c1e-5d3f-4a36-9f63-{:012}", i)}, {"name", std::format("Team {}", i)}});
+        }
+        return body.dump();
+    }
+}
+
+int main() {
+    const std::string team = R"({"name":"Falcons"})";
+    const std::string tournament = R"({"name":"Summer Cup","format":{"numberOfGroups":4,"maxTeamsPerGroup":8,"type":"ROUND_ROBIN"}})";
+
+    size_t sink = 0;
+    std::println("{:>16} {:>14} {:>14}", "body", "decoder ns", "dom ns");
+
+    const double teamDecoder = NanosPerCall([&] { sink += domain::DecodeTeam(team)->Name.size(); });
+    const double teamDom = NanosPerCall([&] {
+        if (nlohmann::json::accept(team)) {
+            const domain::Team decoded = nlohmann::json::parse(team);
+            sink += decoded.Name.size();
+        }
+    });
+    std::println("{:>16} {:>14.0f} {:>14.0f}", "team", teamDecoder, teamDom);
+
+    const double tournamentDecoder = NanosPerCall([&] { sink += domain::DecodeTournament(tournament)->Name().size(); });
+    const double tournamentDom = NanosPerCall([&] {
+        if (nlohmann::json::accept(tournament)) {
+            const domain::Tournament decoded = nlohmann::json::parse(tournament);
+            sink += decoded.Name().size();
+        }
+    });
+    std::println("{:>16} {:>14.0f} {:>14.0f}", "tournament", tournamentDecoder, tournamentDom);
+
+    for (const size_t teams : {4, 32}) {
+        const std::string group = GroupBody(teams);
+        const double groupDecoder = NanosPerCall([&] { sink += domain::DecodeGroup(group)->Teams().size(); });
+        const double groupDom = NanosPerCall([&] {
+            if (nlohmann::json::accept(group)) {
+                const domain::Group decoded = nlohmann::json::parse(group);
+                sink += decoded.Teams().size();
+            }
+        });
+        std::println("{:>16} {:>14.0f} {:>14.0f}", std::format("group/{} teams", teams), groupDecoder, groupDom);
+    }
+
+    return sink == 0;
+}
@@ -0,0 +1,66 @@
+// Publish rate of tournament.created: a session, destination and producer opened for every message
+// (what QueueMessageProducer used to do) against the per-thread cache of ConnectionManager.
+// Messages go to a scratch queue so no consumer sees them.
+//
+//   broker_publish_benchmark "tcp://localhost:61616" [messages]
+
+#include <chrono>
+#include <memory>
+#include <print>
+#include <string>
+#include <cms/MessageProducer.h>
+#include <cms/Session.h>
+#include <cms/TextMessage.h>
+#include <activemq/library/ActiveMQCPP.h>
+
+#include "cms/ConnectionManager.hpp"
+
+namespace {
+    constexpr auto Queue = "benchmark.tournament.created";
+    constexpr auto Payload = "0b7b8a6e-2f4e-4c43-9a52-6a1b8cfe0d11";
+
+    template<typename Publish>
+    double Rate(const int messages, Publish publish) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < messages; i++) {
+            publish();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return messages / elapsed.count();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::println("usage: {} <broker url> [messages]", argv[0]);
+        return 1;
+    }
+    const int messages = argc > 2 ? std::stoi(argv[2]) : 5000;
+
+    activemq::library::ActiveMQCPP::initializeLibrary();
+    {
+        ConnectionManager connectionManager;
+        connectionManager.initialize(argv[1]);
+
+        const double perMessage = Rate(messages, [&] {
+            const auto session = connectionManager.CreateSession();
+            const auto destination = std::unique_ptr<cms::Destination>(session->createQueue(Queue));
+            const auto producer = std::unique_ptr<cms::MessageProducer>(session->createProducer(destination.get()));
+            producer->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+            const auto message = std::unique_ptr<cms::TextMessage>(session->createTextMessage(Payload));
+            producer->send(message.get());
+        });
+
+        const double cached = Rate(messages, [&] {
+            auto [session, producer] = connectionManager.Producer(Queue);
+            const auto message = std::unique_ptr<cms::TextMessage>(session.createTextMessage(Payload));
+            producer.send(message.get());
+        });
+
+        std::println("{} messages to {}", messages, Queue);
+        std::println("  session per message   {:>10.0f} msg/s", perMessage);
+        std::println("  cached producer       {:>10.0f} msg/s", cached);
+    }
+    activemq::library::ActiveMQCPP::shutdownLibrary();
+    return 0;
+}
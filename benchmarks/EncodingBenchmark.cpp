@@ -0,0 +1,57 @@
+// Payload size and encode/decode time of a group list in each negotiable format. Encoding goes
+// through the generated writers, decoding through the SAX decoder the controllers use.
+
+#include <chrono>
+#include <memory>
+#include <print>
+#include <string>
+#include <vector>
+
+#include "domain/Encoding.hpp"
+#include "domain/JsonDecoder.hpp"
+
+namespace {
+    constexpr auto RunFor = std::chrono::milliseconds(500);
+
+    template<typename Work>
+    double MicrosecondsPerCall(Work work) {
+        size_t calls = 0;
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::steady_clock::duration::zero();
+        while (elapsed < RunFor) {
+            for (int i = 0; i < 16; i++) {
+                work();
+            }
+            calls += 16;
+            elapsed = std::chrono::steady_clock::now() - start;
+        }
+        return std::chrono::duration<double, std::micro>(elapsed).count() / static_cast<double>(calls);
+    }
+
+    std::vector<std::shared_ptr<domain::Group>> Groups(const size_t groups, const size_t teamsPerGroup) {
+        std::vector<std::shared_ptr<domain::Group>> result;
+        for (size_t g = 0; g < groups; g++) {
+            auto group = std::make_shared<domain::Group>(std::format("Group {}", g), std::format("5a0c7c1e-5d3f-4a36-9f63-{:012}", g));
+            group->TournamentId() = "7b1d8d2f-6e40-4b47-a074-3b4f2d6c8e21";
+            for (size_t t = 0; t < teamsPerGroup; t++) {
+                group->Teams().push_back({std::format("6c2e9e30-7f51-4c58-b185-{:012}", g * teamsPerGroup + t), std::format("Team \"{}\"", t)});
+            }
+            result.push_back(group);
+        }
+        return result;
+    }
+}
+
+int main() {
+    std::println("{:>8} {:>8} {:>12} {:>10} {:>12} {:>12}", "groups", "teams", "format", "bytes", "encode us", "decode us");
+    for (const auto [groups, teams] : {std::pair<size_t, size_t>{8, 4}, {64, 16}, {512, 16}}) {
+        const auto list = Groups(groups, teams);
+        for (const auto format : {domain::Format::Json, domain::Format::Cbor, domain::Format::MessagePack}) {
+            const std::string payload = domain::Encode(format, list);
+            const double encode = MicrosecondsPerCall([&] { return domain::Encode(format, list).size(); });
+            const double decode = MicrosecondsPerCall([&] { return domain::Decode<std::vector<domain::Group>>(payload, format)->size(); });
+            std::println("{:>8} {:>8} {:>12} {:>10} {:>12.1f} {:>12.1f}", groups, teams, domain::ContentType(format).substr(12), payload.size(), encode, decode);
+        }
+    }
+    return 0;
+}
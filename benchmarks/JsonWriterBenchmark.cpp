@@ -0,0 +1,57 @@
+// Serialization throughput of a group list, the largest response the service sends. The baseline
+// is the previous path: convert to a nlohmann::json tree and dump() it.
+
+#include <chrono>
+#include <memory>
+#include <print>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "domain/JsonWriter.hpp"
+#include "domain/Utilities.hpp"
+
+namespace {
+    constexpr auto RunFor = std::chrono::milliseconds(500);
+
+    template<typename Work>
+    double MegabytesPerSecond(Work work) {
+        size_t bytes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::steady_clock::duration::zero();
+        while (elapsed < RunFor) {
+            for (int i = 0; i < 16; i++) {
+                bytes += work();
+            }
+            elapsed = std::chrono::steady_clock::now() - start;
+        }
+        return static_cast<double>(bytes) / 1e6 / std::chrono::duration<double>(elapsed).count();
+    }
+
+    std::vector<std::shared_ptr<domain::Group>> Groups(const size_t groups, const size_t teamsPerGroup) {
+        std::vector<std::shared_ptr<domain::Group>> result;
+        for (size_t g = 0; g < groups; g++) {
+            auto group = std::make_shared<domain::Group>(std::format("Group {}", g), std::format("5a0c7c1e-5d3f-4a36-9f63-{:012}", g));
+            group->TournamentId() = "7b1d8d2f-6e40-4b47-a074-3b4f2d6c8e21";
+            for (size_t t = 0; t < teamsPerGroup; t++) {
+                group->Teams().push_back({std::format("6c2e9e30-7f51-4c58-b185-{:012}", g * teamsPerGroup + t), std::format("Team \"{}\"", t)});
+            }
+            result.push_back(group);
+        }
+        return result;
+    }
+}
+
+int main() {
+    std::println("{:>8} {:>8} {:>14} {:>14}", "groups", "teams", "writer MB/s", "dom MB/s");
+    for (const auto [groups, teams] : {std::pair<size_t, size_t>{8, 4}, {64, 16}, {512, 16}}) {
+        const auto list = Groups(groups, teams);
+        const double writer = MegabytesPerSecond([&] { return domain::ToJson(list).size(); });
+        const double dom = MegabytesPerSecond([&] {
+            const nlohmann::json body = list;
+            return body.dump().size();
+        });
+        std::println("{:>8} {:>8} {:>14.0f} {:>14.0f}", groups, teams, writer, dom);
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Cost of recording a request on the metrics registry from several threads at once: the per thread
+// shards against one shared set of atomics incremented with fetch_add.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <print>
+#include <thread>
+#include <vector>
+
+#include "metrics/Metrics.hpp"
+
+namespace {
+    constexpr size_t Iterations = 5'000'000;
+
+    struct SharedHistogram {
+        std::array<std::atomic<uint64_t>, metrics::HistogramCells> cells{};
+
+        void Observe(const metrics::Clock::duration elapsed) {
+            uint32_t bucket = 0;
+            while (bucket < metrics::LatencyBuckets.size() && elapsed > metrics::LatencyBuckets[bucket]) {
+                ++bucket;
+            }
+            cells[bucket].fetch_add(1, std::memory_order_relaxed);
+            cells.back().fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), std::memory_order_relaxed);
+        }
+    };
+
+    template<typename Work>
+    double NanosecondsPerCall(const size_t threadCount, Work work) {
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::vector<std::jthread> threads;
+            for (size_t t = 0; t < threadCount; t++) {
+                threads.emplace_back([&] {
+                    for (size_t i = 0; i < Iterations; i++) {
+                        work(std::chrono::microseconds(i & 4095));
+                    }
+                });
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(Iterations);
+    }
+}
+
+int main() {
+    const auto histogram = metrics::Registry::Instance().AddHistogram("benchmark_seconds", "Benchmark.");
+    SharedHistogram shared;
+
+    std::println("{:>8} {:>16} {:>16}", "threads", "shard ns", "shared ns");
+    for (const size_t threads : {1, 2, 4, 8}) {
+        const double shard = NanosecondsPerCall(threads, [&](const auto elapsed) { histogram.Observe(elapsed); });
+        const double atomics = NanosecondsPerCall(threads, [&](const auto elapsed) { shared.Observe(elapsed); });
+        std::println("{:>8} {:>16.1f} {:>16.1f}", threads, shard, atomics);
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+// Per-request dispatch cost of a route handler as the number of worker threads grows. The
+// controller method is trivial so only the dispatch is measured; the baseline resolves the
+// controller from the container on every call, as the route binder used to.
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Hypodermic/Hypodermic.h>
+
+namespace {
+    constexpr auto RunFor = std::chrono::milliseconds(500);
+
+    struct EchoController {
+        [[nodiscard]] size_t Get(const std::string& id) const { return id.size(); }
+    };
+
+    template<typename Work>
+    double OpsPerSecond(const size_t threads, Work work) {
+        std::atomic<bool> stop{false};
+        std::atomic<size_t> total{0};
+        std::vector<std::jthread> workers;
+        for (size_t t = 0; t < threads; t++) {
+            workers.emplace_back([&] {
+                size_t operations = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    work();
+                    ++operations;
+                }
+                total.fetch_add(operations);
+            });
+        }
+        std::this_thread::sleep_for(RunFor);
+        stop = true;
+        workers.clear();
+        return static_cast<double>(total.load()) / std::chrono::duration<double>(RunFor).count();
+    }
+}
+
+int main() {
+    Hypodermic::ContainerBuilder builder;
+    builder.registerType<EchoController>().singleInstance();
+    const auto container = builder.build();
+    const auto captured = container->resolve<EchoController>();
+    const std::string id = "6c2e9e30-7f51-4c58-b185-000000000000";
+    std::atomic<size_t> sink{0};
+
+    std::println("{:>8} {:>16} {:>16}", "threads", "captured op/s", "resolve op/s");
+    for (const size_t threads : {1, 2, 4, 8}) {
+        const double direct = OpsPerSecond(threads, [&] {
+            sink.fetch_add(captured->Get(id), std::memory_order_relaxed);
+        });
+        const double resolved = OpsPerSecond(threads, [&] {
+            const auto controller = container->resolve<EchoController>();
+            sink.fetch_add(controller->Get(id), std::memory_order_relaxed);
+        });
+        std::println("{:>8} {:>16.0f} {:>16.0f}", threads, direct, resolved);
+    }
+    return sink.load() == 0;
+}
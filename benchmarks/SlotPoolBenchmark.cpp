@@ -0,0 +1,97 @@
+// Checkout/return throughput of the connection pool as the number of threads grows.
+// The connection is a dummy so only the handoff itself is measured; the baseline is the
+// mutex + deque + allocated wrapper scheme the pool replaced.
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <print>
+#include <thread>
+#include <vector>
+
+#include "persistence/configuration/SlotPool.hpp"
+
+namespace {
+    struct DummyConnection {
+        size_t uses = 0;
+    };
+
+    constexpr size_t PoolSize = 8;
+    constexpr auto RunFor = std::chrono::milliseconds(500);
+
+    class MutexPool {
+        std::mutex mutex;
+        std::deque<std::unique_ptr<DummyConnection>> idle;
+    public:
+        MutexPool() {
+            for (size_t i = 0; i < PoolSize; i++) {
+                idle.push_back(std::make_unique<DummyConnection>());
+            }
+        }
+
+        // same shape as the old provider: lock, pop, allocate a wrapper with a std::function deleter
+        std::shared_ptr<DummyConnection> Acquire() {
+            while (true) {
+                std::unique_lock lock(mutex);
+                if (!idle.empty()) {
+                    DummyConnection* connection = idle.front().release();
+                    idle.pop_front();
+                    return std::shared_ptr<DummyConnection>(connection, std::function<void(DummyConnection*)>([this](DummyConnection* c) {
+                        std::lock_guard guard(mutex);
+                        idle.emplace_back(c);
+                    }));
+                }
+                lock.unlock();
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    template<typename Work>
+    double OpsPerSecond(const size_t threads, Work work) {
+        std::atomic<bool> stop{false};
+        std::atomic<size_t> total{0};
+        std::vector<std::jthread> workers;
+        for (size_t t = 0; t < threads; t++) {
+            workers.emplace_back([&] {
+                size_t operations = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    work();
+                    ++operations;
+                }
+                total.fetch_add(operations);
+            });
+        }
+        std::this_thread::sleep_for(RunFor);
+        stop = true;
+        workers.clear();
+        return static_cast<double>(total.load()) / std::chrono::duration<double>(RunFor).count();
+    }
+}
+
+int main() {
+    SlotPool<DummyConnection> slotPool({.minSize = PoolSize, .maxSize = PoolSize}, {
+        .create = [] { return std::make_unique<DummyConnection>(); },
+        .isOpen = [](DummyConnection&) { return true; },
+        .ping = [](DummyConnection&) { return true; }
+    });
+    MutexPool mutexPool;
+
+    std::println("{:>8} {:>16} {:>16}", "threads", "slot pool op/s", "mutex pool op/s");
+    for (const size_t threads : {1, 2, 4, 8, 16}) {
+        const double slot = OpsPerSecond(threads, [&] {
+            auto [connection, index] = slotPool.Acquire();
+            ++connection->uses;
+            slotPool.Release(index);
+        });
+        const double mutex = OpsPerSecond(threads, [&] {
+            const auto connection = mutexPool.Acquire();
+            ++connection->uses;
+        });
+        std::println("{:>8} {:>16.0f} {:>16.0f}", threads, slot, mutex);
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+// Cost of validating a path id: Uuid::Parse against the std::regex the controllers used, plus
+// formatting back to text.
+
+#include <chrono>
+#include <print>
+#include <regex>
+#include <string>
+
+#include "domain/Uuid.hpp"
+
+namespace {
+    constexpr size_t Iterations = 2'000'000;
+
+    template<typename Work>
+    double NanosecondsPerCall(Work work) {
+        size_t sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < Iterations; i++) {
+            sink += work(i);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        if (sink == 0) {
+            std::println("unexpected: no work done");
+        }
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(Iterations);
+    }
+}
+
+int main() {
+    static constexpr std::string_view Digits = "0123456789abcdef";
+    const std::regex idValue("[A-Za-z0-9\\-]+");
+    std::string id = "6c2e9e30-7f51-4c58-b185-00000000abcd";
+    const auto uuid = domain::Uuid::Require(id);
+    char text[domain::Uuid::TextSize];
+
+    const double parse = NanosecondsPerCall([&](const size_t i) {
+        id.back() = Digits[i & 15];
+        return static_cast<size_t>(domain::Uuid::Parse(id).has_value());
+    });
+    const double regex = NanosecondsPerCall([&](const size_t i) {
+        id.back() = Digits[i & 15];
+        return static_cast<size_t>(std::regex_match(id, idValue));
+    });
+    const double format = NanosecondsPerCall([&](size_t) {
+        uuid.Format(text);
+        return static_cast<size_t>(text[0]);
+    });
+    std::println("{:>16} {:>16} {:>16}", "parse ns", "regex ns", "format ns");
+    std::println("{:>16.1f} {:>16.1f} {:>16.1f}", parse, regex, format);
+    return 0;
+}
@@ -30,6 +30,8 @@ CREATE TABLE TEAMS (
     created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
 );
 CREATE UNIQUE INDEX team_unique_name_idx ON teams ((document->>'name'));
+-- keyset pagination
+CREATE INDEX team_created_at_id_idx ON TEAMS (created_at, id);
 
 CREATE TABLE TOURNAMENTS (
     id UUID DEFAULT uuid_generate_v4() PRIMARY KEY,
@@ -38,6 +40,9 @@ CREATE TABLE TOURNAMENTS (
     created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
 );
 CREATE UNIQUE INDEX tournament_unique_name_idx ON TOURNAMENTS ((document->>'name'));
+CREATE INDEX tournament_created_at_id_idx ON TOURNAMENTS (created_at, id);
+-- collection version for conditional GET /tournaments, max() reads the end of the index
+CREATE INDEX tournament_last_update_date_idx ON TOURNAMENTS (last_update_date);
 
 CREATE TABLE GROUPS (
     id UUID DEFAULT uuid_generate_v4() PRIMARY KEY,
@@ -47,6 +52,32 @@ CREATE TABLE GROUPS (
     created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
 );
 CREATE UNIQUE INDEX tournament_group_unique_name_idx ON GROUPS (tournament_id,(document->>'name'));
+CREATE INDEX group_tournament_created_at_id_idx ON GROUPS (tournament_id, created_at, id);
+
+-- group membership, kept in sync with GROUPS.document->'teams' by GroupRepository.
+-- A team can be in only one group per tournament.
+CREATE TABLE GROUP_TEAMS (
+    TOURNAMENT_ID UUID not null references TOURNAMENTS(ID),
+    GROUP_ID UUID not null references GROUPS(ID) on delete cascade,
+    TEAM_ID UUID not null references TEAMS(ID) on delete cascade,
+    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+);
+CREATE UNIQUE INDEX group_teams_tournament_team_idx ON GROUP_TEAMS (tournament_id, team_id);
+CREATE INDEX group_teams_group_idx ON GROUP_TEAMS (group_id);
+
+-- databases created before GROUP_TEAMS existed: run migrations/001_group_teams.sql instead
+
+-- transactional outbox: events written with the change that caused them, published and removed by
+-- OutboxRelay. The id gives the publishing order, claimed_until the end of a relay's claim.
+CREATE TABLE OUTBOX (
+    id BIGSERIAL PRIMARY KEY,
+    queue TEXT NOT NULL,
+    payload TEXT NOT NULL,
+    claimed_until TIMESTAMPTZ,
+    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+);
+
+-- databases created before OUTBOX had claims: run migrations/002_outbox_claims.sql instead
 
 CREATE TABLE MATCHES (
     id UUID DEFAULT uuid_generate_v4() PRIMARY KEY,
@@ -59,3 +90,4 @@ GRANT SELECT ON ALL TABLES IN SCHEMA public TO tournament_svc;
 GRANT DELETE ON ALL TABLES IN SCHEMA public TO tournament_svc;
 GRANT UPDATE ON ALL TABLES IN SCHEMA public TO tournament_svc;
 GRANT INSERT ON ALL TABLES IN SCHEMA public TO tournament_svc;
+GRANT USAGE ON ALL SEQUENCES IN SCHEMA public TO tournament_svc;
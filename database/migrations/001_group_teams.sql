@@ -0,0 +1,30 @@
+-- Brings a database created before GROUP_TEAMS existed up to db_script.sql. Safe to run again.
+-- podman exec -i tournament_db psql -U tournament_admin -d tournament_db < migrations/001_group_teams.sql
+
+BEGIN;
+
+CREATE TABLE IF NOT EXISTS GROUP_TEAMS (
+    TOURNAMENT_ID UUID not null references TOURNAMENTS(ID),
+    GROUP_ID UUID not null references GROUPS(ID) on delete cascade,
+    TEAM_ID UUID not null references TEAMS(ID) on delete cascade,
+    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+);
+CREATE UNIQUE INDEX IF NOT EXISTS group_teams_tournament_team_idx ON GROUP_TEAMS (tournament_id, team_id);
+CREATE INDEX IF NOT EXISTS group_teams_group_idx ON GROUP_TEAMS (group_id);
+
+-- tables created by an earlier version of this migration lack the cascade on TEAM_ID
+ALTER TABLE GROUP_TEAMS DROP CONSTRAINT IF EXISTS group_teams_team_id_fkey;
+ALTER TABLE GROUP_TEAMS ADD CONSTRAINT group_teams_team_id_fkey
+    FOREIGN KEY (TEAM_ID) REFERENCES TEAMS(ID) on delete cascade;
+
+-- membership so far only lived in GROUPS.document->'teams'. Ids of deleted teams are skipped,
+-- a team listed in two groups of a tournament is recorded in one of them.
+INSERT INTO GROUP_TEAMS (tournament_id, group_id, team_id)
+SELECT g.tournament_id, g.id, (team->>'id')::uuid
+FROM GROUPS g, jsonb_array_elements(coalesce(g.document->'teams', '[]'::jsonb)) team
+WHERE EXISTS (SELECT 1 FROM TEAMS t WHERE t.id = (team->>'id')::uuid)
+ON CONFLICT DO NOTHING;
+
+GRANT SELECT, INSERT, UPDATE, DELETE ON GROUP_TEAMS TO tournament_svc;
+
+COMMIT;
@@ -0,0 +1,18 @@
+-- Brings a database created before OUTBOX existed, or before relays claimed its rows, up to
+-- db_script.sql. Safe to run again.
+-- podman exec -i tournament_db psql -U tournament_admin -d tournament_db < migrations/002_outbox_claims.sql
+
+BEGIN;
+
+CREATE TABLE IF NOT EXISTS OUTBOX (
+    id BIGSERIAL PRIMARY KEY,
+    queue TEXT NOT NULL,
+    payload TEXT NOT NULL,
+    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+);
+ALTER TABLE OUTBOX ADD COLUMN IF NOT EXISTS claimed_until TIMESTAMPTZ;
+
+GRANT SELECT, INSERT, UPDATE, DELETE ON OUTBOX TO tournament_svc;
+GRANT USAGE ON SEQUENCE outbox_id_seq TO tournament_svc;
+
+COMMIT;
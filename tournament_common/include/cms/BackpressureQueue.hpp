@@ -0,0 +1,196 @@
+#ifndef COMMON_BACKPRESSURE_QUEUE_HPP
+#define COMMON_BACKPRESSURE_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "cms/BoundedQueue.hpp"
+
+// What Push does when the queue is full.
+enum class Backpressure {
+    // wait up to blockTimeout for room, then drop the value
+    Block,
+    // drop the value being pushed
+    DropNewest,
+    // drop the oldest queued value to make room
+    DropOldest
+};
+
+// A BoundedQueue with one consumer thread that parks while it is empty, and a backpressure policy
+// for producers that find it full. Stop() wakes everyone: blocked producers give up, the consumer
+// keeps popping until the queue is empty.
+template<typename T>
+class BackpressureQueue {
+    using Clock = std::chrono::steady_clock;
+
+    BoundedQueue<T> values;
+    Backpressure policy;
+    std::chrono::milliseconds blockTimeout;
+
+    std::mutex parkMutex;
+    // the consumer waits here for values, Block producers for room
+    std::condition_variable consumerCondition;
+    std::condition_variable spaceCondition;
+    std::atomic<bool> consumerParked{false};
+    std::atomic<size_t> spaceWaiters{0};
+    std::atomic<uint64_t> spaceGeneration{0};
+    std::atomic<bool> stopping{false};
+
+public:
+    struct PushResult {
+        bool queued = false;
+        // queued values dropped to make room, DropOldest only
+        size_t evicted = 0;
+    };
+
+    BackpressureQueue(const size_t capacity, const Backpressure policy, const std::chrono::milliseconds blockTimeout)
+        : values(capacity), policy(policy), blockTimeout(blockTimeout) {}
+
+    BackpressureQueue(const BackpressureQueue&) = delete;
+    BackpressureQueue& operator=(const BackpressureQueue&) = delete;
+
+    // value is moved from only when it was queued.
+    PushResult Push(T& value) {
+        PushResult result;
+        result.queued = values.TryPush(value) || Overflow(value, result.evicted);
+        if (!result.queued) {
+            return result;
+        }
+        // pairs with the fence in WaitForValues(): either the consumer sees the value or we see it
+        // parked
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (consumerParked.load(std::memory_order_relaxed)) {
+            {
+                std::lock_guard lock(parkMutex);
+            }
+            consumerCondition.notify_one();
+        }
+        return result;
+    }
+
+    // Consumer side: moves up to max values into batch and lets blocked producers retry.
+    size_t PopBatch(std::vector<T>& batch, const size_t max) {
+        size_t taken = 0;
+        T value;
+        while (taken < max && values.TryPop(value)) {
+            batch.push_back(std::move(value));
+            taken++;
+        }
+        if (taken > 0) {
+            WakeBlocked();
+        }
+        return taken;
+    }
+
+    // Consumer side: parks until a value is ready or Stop() was called. False once stopped and empty.
+    bool WaitForValues() {
+        while (values.Size() == 0) {
+            if (stopping.load(std::memory_order_acquire)) {
+                return false;
+            }
+            consumerParked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            {
+                std::unique_lock lock(parkMutex);
+                consumerCondition.wait(lock, [&] {
+                    return values.Size() > 0 || stopping.load(std::memory_order_relaxed);
+                });
+            }
+            consumerParked.store(false, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    // Consumer side: a pause that Stop() cuts short, for retry backoff.
+    void Pause(const std::chrono::milliseconds duration) {
+        std::unique_lock lock(parkMutex);
+        consumerCondition.wait_for(lock, duration, [&] { return stopping.load(std::memory_order_relaxed); });
+    }
+
+    void Stop() {
+        stopping.store(true, std::memory_order_seq_cst);
+        {
+            std::lock_guard lock(parkMutex);
+        }
+        consumerCondition.notify_one();
+        spaceCondition.notify_all();
+    }
+
+    [[nodiscard]] bool Stopping() const {
+        return stopping.load(std::memory_order_acquire);
+    }
+
+    // Approximate while other threads push or pop; a push that claimed its cell but did not fill it
+    // yet is counted.
+    [[nodiscard]] size_t Size() const {
+        return values.Size();
+    }
+
+    [[nodiscard]] size_t Capacity() const {
+        return values.Capacity();
+    }
+
+private:
+    // The queue is full. True once the value was queued after all.
+    bool Overflow(T& value, size_t& evicted) {
+        switch (policy) {
+            case Backpressure::DropNewest:
+                return false;
+            case Backpressure::DropOldest:
+                for (size_t attempt = 0; attempt < 8; attempt++) {
+                    if (T oldest; values.TryPop(oldest)) {
+                        evicted++;
+                    }
+                    if (values.TryPush(value)) {
+                        return true;
+                    }
+                }
+                return false;
+            case Backpressure::Block:
+            default:
+                break;
+        }
+
+        const auto deadline = Clock::now() + blockTimeout;
+        spaceWaiters.fetch_add(1, std::memory_order_seq_cst);
+        struct Leave {
+            std::atomic<size_t>& waiters;
+            ~Leave() { waiters.fetch_sub(1, std::memory_order_relaxed); }
+        } leave{spaceWaiters};
+
+        while (!stopping.load(std::memory_order_relaxed)) {
+            const uint64_t seen = spaceGeneration.load(std::memory_order_relaxed);
+            if (values.TryPush(value)) {
+                return true;
+            }
+            std::unique_lock lock(parkMutex);
+            if (!spaceCondition.wait_until(lock, deadline, [&] {
+                return spaceGeneration.load(std::memory_order_relaxed) != seen || stopping.load(std::memory_order_relaxed);
+            })) {
+                lock.unlock();
+                return values.TryPush(value);
+            }
+        }
+        return false;
+    }
+
+    // Called by the consumer after it took values off the queue.
+    void WakeBlocked() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (spaceWaiters.load(std::memory_order_relaxed) > 0) {
+            spaceGeneration.fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard lock(parkMutex);
+            }
+            spaceCondition.notify_all();
+        }
+    }
+};
+
+#endif //COMMON_BACKPRESSURE_QUEUE_HPP
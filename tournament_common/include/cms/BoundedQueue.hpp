@@ -0,0 +1,96 @@
+#ifndef COMMON_BOUNDED_QUEUE_HPP
+#define COMMON_BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Fixed capacity ring shared by any number of pushing and popping threads, lock free (Dmitry
+// Vyukov's bounded MPMC queue). Every cell carries a sequence number: a cell whose sequence equals
+// the enqueue position is free for that push, one equal to the dequeue position plus one holds the
+// value for that pop. Pushing and popping never allocate beyond what moving a T does.
+template<typename T>
+class BoundedQueue {
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    // on separate cache lines, producers and the consumer do not invalidate each other
+    alignas(64) std::atomic<size_t> enqueuePosition{0};
+    alignas(64) std::atomic<size_t> dequeuePosition{0};
+
+public:
+    // capacity is rounded up to a power of two
+    explicit BoundedQueue(const size_t capacity)
+        : cells(std::make_unique<Cell[]>(std::bit_ceil(capacity < 2 ? size_t{2} : capacity))),
+          mask(std::bit_ceil(capacity < 2 ? size_t{2} : capacity) - 1) {
+        for (size_t i = 0; i <= mask; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // False, and value is left alone, when the queue is full.
+    bool TryPush(T& value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto distance = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (distance == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (distance < 0) {
+                return false;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // False when no value is ready, a push that claimed its cell but did not fill it yet counts as
+    // not ready.
+    bool TryPop(T& value) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto distance = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (distance == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (distance < 0) {
+                return false;
+            } else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Approximate while other threads push or pop.
+    [[nodiscard]] size_t Size() const {
+        const size_t dequeued = dequeuePosition.load(std::memory_order_acquire);
+        const size_t enqueued = enqueuePosition.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    [[nodiscard]] size_t Capacity() const {
+        return mask + 1;
+    }
+};
+
+#endif //COMMON_BOUNDED_QUEUE_HPP
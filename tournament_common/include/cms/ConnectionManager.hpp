@@ -6,28 +6,221 @@
 #define SERVICES_CONNECTION_MANAGER_HPP
 
 #include <cms/Connection.h>
+#include <cms/ExceptionListener.h>
+#include <cms/MessageProducer.h>
 #include <cms/Session.h>
 #include <activemq/core/ActiveMQConnectionFactory.h>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
-class ConnectionManager {
+// Owns the broker connection and caches what publishing needs. cms sessions are single threaded,
+// so every thread gets its own session plus one producer per destination, created on first use and
+// reused for every later message. A connection failure reported by the broker client replaces the
+// connection and invalidates every cache, a failed send drops the cache of the thread that saw it.
+//
+// The caches are registered with the manager. Its destructor closes every one of them, so no
+// session or producer outlives it and, with it, the broker library; a thread that exits first
+// closes its own. No thread may still be sending when the manager is destroyed.
+class ConnectionManager : public cms::ExceptionListener {
 public:
+    struct CachedProducer {
+        cms::Session& session;
+        cms::MessageProducer& producer;
+    };
+
+    ConnectionManager() = default;
+
+    ~ConnectionManager() override {
+        CloseThreadCaches();
+        if (connection) {
+            connection->setExceptionListener(nullptr);
+        }
+    }
+
+    ConnectionManager(const ConnectionManager&) = delete;
+    ConnectionManager& operator=(const ConnectionManager&) = delete;
+
     void initialize(const std::string_view& brokerURI) {
         factory = std::make_unique<activemq::core::ActiveMQConnectionFactory>(brokerURI.data());
-        connection = std::shared_ptr<cms::Connection>(factory->createConnection());
+        std::lock_guard lock(connectionMutex);
+        Open();
+    }
 
-        connection->start();
+    [[nodiscard]] std::shared_ptr<cms::Connection> Connection() const {
+        std::lock_guard lock(connectionMutex);
+        return connection;
     }
 
-    [[nodiscard]] std::shared_ptr<cms::Connection> Connection() const { return connection; }
+    // Changes every time the connection is replaced. Holders of sessions compare it with the one
+    // they opened them at and reopen on Connection() when it moved.
+    [[nodiscard]] uint64_t Generation() const {
+        return generation.load(std::memory_order_acquire);
+    }
 
     [[nodiscard]] std::shared_ptr<cms::Session> CreateSession() const {
-        return std::shared_ptr<cms::Session>(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+        return std::shared_ptr<cms::Session>(Connection()->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+    }
+
+    // Session and producer for queue owned by the calling thread. Valid until the next call that
+    // invalidates the cache, do not keep them past the send.
+    CachedProducer Producer(const std::string_view& queue) {
+        ThreadCache& cache = LocalCache();
+        if (!cache.session || cache.generation != generation.load(std::memory_order_acquire)) {
+            cache.Clear();
+            cache.generation = generation.load(std::memory_order_acquire);
+            cache.connection = Connection();
+            cache.session.reset(cache.connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+        }
+
+        auto found = cache.producers.find(queue);
+        if (found == cache.producers.end()) {
+            QueueProducer queueProducer;
+            queueProducer.destination.reset(cache.session->createQueue(std::string{queue}));
+            queueProducer.producer.reset(cache.session->createProducer(queueProducer.destination.get()));
+            queueProducer.producer->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+            found = cache.producers.emplace(std::string{queue}, std::move(queueProducer)).first;
+        }
+        return {*cache.session, *found->second.producer};
+    }
+
+    // Forgets the calling thread's session and producers, the next Producer() call opens new ones.
+    void DiscardThreadCache() {
+        if (ThreadSlot& slot = LocalSlot(); slot.owner == instance) {
+            slot.cache->Clear();
+        }
+    }
+
+    // The connection is gone for good (the failover transport has given up): open a new one and make
+    // every thread rebuild its session on its next send.
+    void onException(const cms::CMSException&) override {
+        std::lock_guard lock(connectionMutex);
+        generation.fetch_add(1, std::memory_order_acq_rel);
+        if (factory) {
+            try {
+                Open();
+            } catch (const cms::CMSException&) {
+                // the next send fails and reports it, a later onException tries again
+            }
+        }
     }
 
 private:
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(const std::string_view value) const { return std::hash<std::string_view>{}(value); }
+    };
+
+    struct QueueProducer {
+        std::unique_ptr<cms::Destination> destination;
+        std::unique_ptr<cms::MessageProducer> producer;
+    };
+
+    // One thread's session and producers. Clear() destroys them bottom up: producers before their
+    // session, the session before the connection it came from.
+    struct ThreadCache {
+        uint64_t generation = 0;
+        std::shared_ptr<cms::Connection> connection;
+        std::unique_ptr<cms::Session> session;
+        std::unordered_map<std::string, QueueProducer, StringHash, std::equal_to<>> producers;
+
+        void Clear() {
+            producers.clear();
+            session.reset();
+            connection.reset();
+        }
+    };
+
+    // The caches a manager created. Shared with the threads, so a thread that exits after the
+    // manager can still unregister, its cache was emptied by the manager already.
+    struct CacheRegistry {
+        std::mutex mutex;
+        std::unordered_set<ThreadCache*> caches;
+    };
+
+    // What a thread holds: its cache for one manager at a time.
+    struct ThreadSlot {
+        uint64_t owner = 0;
+        std::shared_ptr<CacheRegistry> registry;
+        std::unique_ptr<ThreadCache> cache;
+
+        ThreadSlot() = default;
+        ThreadSlot(const ThreadSlot&) = delete;
+        ThreadSlot& operator=(const ThreadSlot&) = delete;
+
+        ~ThreadSlot() {
+            Release();
+        }
+
+        void Release() {
+            if (!registry) {
+                return;
+            }
+            // the registry outlives the lock even when this slot held the last reference
+            std::shared_ptr<CacheRegistry> held = std::move(registry);
+            std::lock_guard lock(held->mutex);
+            held->caches.erase(cache.get());
+            // empty already when the manager is gone
+            cache.reset();
+            owner = 0;
+        }
+    };
+
+    static ThreadSlot& LocalSlot() {
+        thread_local ThreadSlot slot;
+        return slot;
+    }
+
+    // The calling thread's cache for this manager, registered on first use.
+    ThreadCache& LocalCache() {
+        ThreadSlot& slot = LocalSlot();
+        if (slot.owner != instance) {
+            slot.Release();
+            auto cache = std::make_unique<ThreadCache>();
+            {
+                std::lock_guard lock(registry->mutex);
+                registry->caches.insert(cache.get());
+            }
+            slot.owner = instance;
+            slot.registry = registry;
+            slot.cache = std::move(cache);
+        }
+        return *slot.cache;
+    }
+
+    // Shutdown hook: closes the session and producers of every thread while the broker library is
+    // still up, instead of at thread exit.
+    void CloseThreadCaches() {
+        std::lock_guard lock(registry->mutex);
+        for (ThreadCache* cache : registry->caches) {
+            cache->Clear();
+        }
+        registry->caches.clear();
+    }
+
+    static uint64_t NextInstance() {
+        static std::atomic<uint64_t> instances{0};
+        return instances.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    void Open() {
+        connection = std::shared_ptr<cms::Connection>(factory->createConnection());
+        connection->setExceptionListener(this);
+        connection->start();
+    }
+
+    // tells the thread caches of different managers apart
+    const uint64_t instance = NextInstance();
+    std::atomic<uint64_t> generation{0};
+    std::shared_ptr<CacheRegistry> registry = std::make_shared<CacheRegistry>();
     std::unique_ptr<activemq::core::ActiveMQConnectionFactory> factory;
+    mutable std::mutex connectionMutex;
     std::shared_ptr<cms::Connection> connection;
 };
 
-#endif //SERVICES_CONNECTION_MANAGER_HPP
\ No newline at end of file
+#endif //SERVICES_CONNECTION_MANAGER_HPP
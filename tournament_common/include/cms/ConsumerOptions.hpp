@@ -0,0 +1,18 @@
+#ifndef COMMON_CONSUMER_OPTIONS_HPP
+#define COMMON_CONSUMER_OPTIONS_HPP
+
+#include <cstddef>
+
+// How QueueMessageConsumer consumes one queue.
+struct ConsumerOptions {
+    // sessions consuming the queue, each has its own receiving thread
+    size_t sessions = 1;
+    // messages of one session handed to the pool and acknowledged together, which also bounds the
+    // messages of that session in flight
+    size_t ackBatchSize = 32;
+    // handlers of the queue running at once on the shared pool, 0 for no limit beyond
+    // sessions * ackBatchSize. Messages over the limit wait without holding a pool thread.
+    size_t maxConcurrency = 0;
+};
+
+#endif //COMMON_CONSUMER_OPTIONS_HPP
@@ -0,0 +1,17 @@
+#ifndef COMMON_IBATCH_SENDER_HPP
+#define COMMON_IBATCH_SENDER_HPP
+
+#include <string>
+
+// Sends messages in batches: Send() any number of them, Commit() hands them to the broker at once.
+// After a failure call Reset(), the next Send() starts over.
+class IBatchSender {
+public:
+    virtual ~IBatchSender() = default;
+    virtual void Send(const std::string& queue, const std::string& message) = 0;
+    // Returns once the broker accepted everything sent since the last commit.
+    virtual void Commit() = 0;
+    virtual void Reset() = 0;
+};
+
+#endif //COMMON_IBATCH_SENDER_HPP
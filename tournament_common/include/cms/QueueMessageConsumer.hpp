@@ -5,96 +5,393 @@
 #ifndef COMMON_QUEUE_MESSAGE_CONSUMER_HPP
 #define COMMON_QUEUE_MESSAGE_CONSUMER_HPP
 
-
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <print>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
+#include <cms/CMSException.h>
+#include <cms/Message.h>
 #include <cms/MessageConsumer.h>
 #include <cms/Session.h>
-#include <print>
+#include <cms/TextMessage.h>
 
 #include "cms/ConnectionManager.hpp"
+#include "cms/ConsumerOptions.hpp"
+#include "cms/WorkStealingPool.hpp"
+#include "metrics/Metrics.hpp"
 
-class QueueMessageConsumer : public cms::MessageListener {
-    std::shared_ptr<ConnectionManager> connectionManager;
-    std::atomic<bool> running;
-    std::thread worker;
-    // std::shared_ptr<cms::Connection> connection;
-    std::shared_ptr<cms::Session> session;
-    std::shared_ptr<cms::MessageConsumer> messageConsumer;
-
-    // void readMessage();
+// Consumes one queue with several CLIENT_ACKNOWLEDGE sessions. Every session belongs to one lane
+// thread, the only thread that calls it: it receives a message, copies the payload and submits the
+// handler to the shared WorkStealingPool, so handlers run in parallel across sessions and across
+// messages of a session.
+//
+// Acknowledging a message acknowledges everything its session delivered before, so a lane settles
+// once all its delivered messages are handled: when its window of ackBatchSize is full it waits for
+// the pool to finish it, when messages stop arriving it settles at the next receive timeout. If
+// every handler succeeded one ack covers the window. If one threw, the session is recovered
+// instead: the broker redelivers the whole window, and after its redelivery limit moves the failing
+// message to the dead letter queue. Handlers must therefore tolerate seeing a message again.
+//
+// When the ConnectionManager replaces a lost connection, or a receive fails, a lane drops its
+// session and opens a new one on the current connection; its unsettled messages are redelivered.
+// Several consumers share one pool, maxConcurrency keeps one busy queue from taking all of it.
+class QueueMessageConsumer {
 public:
-    explicit QueueMessageConsumer(const std::shared_ptr<ConnectionManager>& connectionManager);
-    ~QueueMessageConsumer();
-    void Start(const std::string_view & queueName);
-    void Stop();
-    virtual void onMessage(const cms::Message* message);
-};
+    using Handler = std::function<void(const std::string&)>;
+
+private:
+    struct Metrics {
+        metrics::Counter processed;
+        metrics::Counter failures;
+        metrics::Histogram handlerTime;
+        metrics::Histogram lag;
+    };
+
+    // how long a lane waits for a message, short while handlers are running so it settles soon
+    // after they finish
+    static constexpr int IdleReceiveMs = 250;
+    static constexpr int BusyReceiveMs = 20;
+
+    class Lane {
+        QueueMessageConsumer& owner;
+        // kept so the session never outlives the connection it came from
+        std::shared_ptr<cms::Connection> connection;
+        // ConnectionManager::Generation() the session was opened at
+        uint64_t generation = 0;
+        std::unique_ptr<cms::Session> session;
+        std::unique_ptr<cms::Queue> destination;
+        std::unique_ptr<cms::MessageConsumer> consumer;
+
+        std::mutex mutex;
+        std::condition_variable handled;
+        uint64_t delivered = 0;
+        uint64_t completed = 0;
+        uint64_t settled = 0;
+        // a handler of the unsettled messages threw
+        bool failed = false;
+        // the newest delivered message, acknowledging it acknowledges the whole session; lane thread only
+        std::unique_ptr<cms::Message> newest;
+
+        std::atomic<bool> stopping{false};
+        // declared last, started once everything above is constructed
+        std::thread thread;
+
+        // Runs on the pool, never touches the session.
+        void Process(const std::string& payload) {
+            bool succeeded = false;
+            {
+                const metrics::Timer timer{owner.metrics.handlerTime};
+                try {
+                    owner.handler(payload);
+                    succeeded = true;
+                } catch (const std::exception& e) {
+                    std::println(stderr, "handler for {} failed: {}", owner.queueName, e.what());
+                } catch (...) {
+                    std::println(stderr, "handler for {} failed with an unknown exception", owner.queueName);
+                }
+            }
+            if (!succeeded) {
+                owner.metrics.failures.Add();
+            }
+            owner.metrics.processed.Add();
+
+            // notified under the lock: once it is released the lane may be destroyed
+            std::lock_guard lock(mutex);
+            failed = failed || !succeeded;
+            if (++completed == delivered) {
+                handled.notify_one();
+            }
+        }
+
+        // Once every delivered message was handled, acknowledges them or, when one failed, hands them
+        // back to the broker.
+        void Settle() {
+            bool recover;
+            {
+                std::lock_guard lock(mutex);
+                if (completed != delivered || settled == delivered) {
+                    return;
+                }
+                recover = failed;
+                failed = false;
+                settled = delivered;
+            }
+            try {
+                if (recover) {
+                    session->recover();
+                } else {
+                    newest->acknowledge();
+                }
+            } catch (const cms::CMSException& e) {
+                // the session is gone, the broker redelivers to another one
+                std::println(stderr, "settling {} failed: {}", owner.queueName, e.what());
+            }
+            newest.reset();
+        }
+
+        // Opens the session and consumer on the manager's current connection.
+        void Open() {
+            generation = owner.connectionManager->Generation();
+            connection = owner.connectionManager->Connection();
+            session.reset(connection->createSession(cms::Session::CLIENT_ACKNOWLEDGE));
+            destination.reset(session->createQueue(owner.queueName));
+            consumer.reset(session->createConsumer(destination.get()));
+        }
+
+        void CloseSession() {
+            try {
+                if (consumer) {
+                    consumer->close();
+                }
+                if (session) {
+                    session->close();
+                }
+            } catch (const cms::CMSException&) {
+                // closing a session of a broken connection, nothing left to release
+            }
+            consumer.reset();
+            destination.reset();
+            session.reset();
+            connection.reset();
+        }
+
+        // Replaces a session that can no longer receive. Its unsettled messages cannot be
+        // acknowledged any more, the broker redelivers them. False while no new session can be
+        // opened; the lane keeps trying.
+        bool Reopen() {
+            {
+                std::unique_lock lock(mutex);
+                handled.wait(lock, [&] { return completed == delivered; });
+                settled = delivered;
+                failed = false;
+            }
+            newest.reset();
+            CloseSession();
+            try {
+                Open();
+                return true;
+            } catch (const cms::CMSException& e) {
+                std::println(stderr, "reopening the session of {} failed: {}", owner.queueName, e.what());
+                CloseSession();
+                return false;
+            }
+        }
+
+        // Waits before the next attempt after a failure; Close() does not wait for it to run out.
+        void Backoff() {
+            std::unique_lock lock(mutex);
+            handled.wait_for(lock, std::chrono::seconds(1), [&] { return stopping.load(std::memory_order_acquire); });
+        }
+
+        void Deliver(std::unique_ptr<cms::Message> message) {
+            const auto sent = std::chrono::system_clock::time_point(std::chrono::milliseconds(message->getCMSTimestamp()));
+            const auto lag = std::max(std::chrono::duration_cast<metrics::Clock::duration>(std::chrono::system_clock::now() - sent),
+                                      metrics::Clock::duration::zero());
+            owner.metrics.lag.Observe(lag);
+            owner.lastLag.store(std::chrono::duration_cast<std::chrono::milliseconds>(lag).count(), std::memory_order_relaxed);
+            const auto* text = dynamic_cast<const cms::TextMessage*>(message.get());
+            std::string payload = text != nullptr ? text->getText() : std::string{};
+
+            {
+                std::lock_guard lock(mutex);
+                delivered++;
+            }
+            newest = std::move(message);
+            owner.Dispatch([this, payload = std::move(payload)] { Process(payload); });
+        }
 
-inline QueueMessageConsumer::QueueMessageConsumer(const std::shared_ptr<ConnectionManager>& connectionManager) : connectionManager(connectionManager) {
-    std::print("Created QueueMessageConsumer");
-}
-
-inline QueueMessageConsumer::~QueueMessageConsumer() {
-    Stop();
-}
-
-inline void QueueMessageConsumer::Start(const std::string_view& queueName) {
-    if (this->running)
-        return;
-    this->running = true;
-    try {
-        session = connectionManager->CreateSession();
-        const auto destination = std::unique_ptr<cms::Queue>(session->createQueue(queueName.data()));
-        auto consumer = std::unique_ptr<cms::MessageConsumer>(session->createConsumer(destination.get()));
-
-        while (running) {
-            std::unique_ptr<cms::Message> message(consumer->receive(1500));
-            if (message) {
-                if (auto text = dynamic_cast<cms::TextMessage*>(message.get())) {
-                    std::print("message consumed: {}", text->getText());
+        void Run() {
+            bool broken = false;
+            while (!stopping.load(std::memory_order_acquire)) {
+                if (broken || generation != owner.connectionManager->Generation()) {
+                    broken = !Reopen();
+                    if (broken) {
+                        Backoff();
+                        continue;
+                    }
                 }
+                Settle();
+                bool busy;
+                {
+                    std::unique_lock lock(mutex);
+                    if (delivered - settled >= owner.options.ackBatchSize) {
+                        handled.wait(lock, [&] { return completed == delivered; });
+                        continue;
+                    }
+                    busy = completed != delivered;
+                }
+                try {
+                    std::unique_ptr<cms::Message> message(consumer->receive(busy ? BusyReceiveMs : IdleReceiveMs));
+                    if (message) {
+                        Deliver(std::move(message));
+                    }
+                } catch (const cms::CMSException& e) {
+                    // the connection may have been replaced, or be about to: reopen on the next pass
+                    std::println(stderr, "receiving from {} failed: {}", owner.queueName, e.what());
+                    broken = true;
+                    Backoff();
+                }
+            }
+
+            {
+                std::unique_lock lock(mutex);
+                handled.wait(lock, [&] { return completed == delivered; });
+            }
+            if (session) {
+                Settle();
+            }
+            CloseSession();
+        }
+
+    public:
+        explicit Lane(QueueMessageConsumer& owner) : owner(owner) {
+            Open();
+            thread = std::thread([this] { Run(); });
+        }
+
+        // Stops receiving and waits until every delivered message was handled and settled.
+        void Close() {
+            {
+                std::lock_guard lock(mutex);
+                stopping.store(true, std::memory_order_release);
+            }
+            handled.notify_all();
+            if (thread.joinable()) {
+                thread.join();
             }
         }
-    } catch (const cms::CMSException& e) {
 
+        ~Lane() {
+            Close();
+        }
+    };
+
+    std::shared_ptr<ConnectionManager> connectionManager;
+    std::shared_ptr<WorkStealingPool> pool;
+    std::string queueName;
+    Handler handler;
+    ConsumerOptions options;
+    Metrics metrics;
+    std::atomic<int64_t> lastLag{0};
+
+    // handlers of this queue on the pool and the ones waiting for a slot under maxConcurrency
+    std::mutex dispatchMutex;
+    std::condition_variable idle;
+    size_t running = 0;
+    std::deque<std::function<void()>> waiting;
+
+    std::vector<std::unique_ptr<Lane>> lanes;
+
+    void Dispatch(std::function<void()> task) {
+        if (options.maxConcurrency == 0) {
+            pool->Submit(std::move(task));
+            return;
+        }
+        {
+            std::lock_guard lock(dispatchMutex);
+            if (running >= options.maxConcurrency) {
+                waiting.push_back(std::move(task));
+                return;
+            }
+            running++;
+        }
+        pool->Submit(Limited(std::move(task)));
     }
-}
 
-inline void QueueMessageConsumer::Stop() {
-    running = false;
-    if (worker.joinable())
-        worker.join();
+    // Runs task, then hands its slot to the next waiting task of the queue.
+    std::function<void()> Limited(std::function<void()> task) {
+        return [this, task = std::move(task)] {
+            task();
+            std::function<void()> next;
+            {
+                std::lock_guard lock(dispatchMutex);
+                if (waiting.empty()) {
+                    if (--running == 0) {
+                        idle.notify_all();
+                    }
+                    return;
+                }
+                next = std::move(waiting.front());
+                waiting.pop_front();
+            }
+            pool->Submit(Limited(std::move(next)));
+        };
+    }
 
-    messageConsumer->close();
-    session->close();
-    // connection->close();
-}
+public:
+    QueueMessageConsumer(const std::shared_ptr<ConnectionManager>& connectionManager,
+                         const std::shared_ptr<WorkStealingPool>& pool)
+        : connectionManager(connectionManager), pool(pool) {}
 
-inline void QueueMessageConsumer::onMessage(const cms::Message* message) {
+    ~QueueMessageConsumer() {
+        Stop();
+    }
 
-}
+    QueueMessageConsumer(const QueueMessageConsumer&) = delete;
+    QueueMessageConsumer& operator=(const QueueMessageConsumer&) = delete;
 
-// inline void QueueMessageConsumer::readMessage() {
-//     try {
-//         if (this->running)
-//             return;
-//         session = connectionManager->CreateSession();
-//         const auto destination = std::unique_ptr<cms::Destination>(session->createQueue(queueName));
-//         auto consumer = std::unique_ptr<cms::MessageConsumer>(session->createConsumer(destination.get()));
-//
-//         while (running) {
-//             std::unique_ptr<cms::Message> message(consumer->receive(1000));
-//             if (message) {
-//                 if (auto text = dynamic_cast<cms::TextMessage*>(message.get())) {
-//                     std::print("message consumed: {}", text->getText());
-//                 }
-//             }
-//         }
-//     } catch (const cms::CMSException& e) {
-//
-//     }
-// }
+    // Opens the sessions and returns, messages are handled on the pool until Stop().
+    void Start(const std::string_view& queue, Handler messageHandler, const ConsumerOptions& consumerOptions = {}) {
+        if (!lanes.empty()) {
+            return;
+        }
+        queueName = queue;
+        handler = std::move(messageHandler);
+        options = consumerOptions;
+        options.sessions = std::max<size_t>(options.sessions, 1);
+        options.ackBatchSize = std::max<size_t>(options.ackBatchSize, 1);
+
+        auto& registry = metrics::Registry::Instance();
+        const std::string labels = metrics::Label("queue", queueName);
+        metrics = {
+            registry.AddCounter("consumer_messages_total", "Messages handled, failed ones included.", labels),
+            registry.AddCounter("consumer_handler_failures_total", "Messages whose handler threw.", labels),
+            registry.AddHistogram("consumer_handler_duration_seconds", "Time spent in the message handler.", labels),
+            registry.AddHistogram("consumer_lag_seconds", "Time from the broker timestamp of a message to its delivery.", labels)
+        };
+
+        for (size_t i = 0; i < options.sessions; i++) {
+            lanes.push_back(std::make_unique<Lane>(*this));
+        }
+    }
+
+    void Stop() {
+        for (const auto& lane : lanes) {
+            lane->Close();
+        }
+        {
+            // the last limited task may still be handing its slot back
+            std::unique_lock lock(dispatchMutex);
+            idle.wait(lock, [&] { return running == 0; });
+        }
+        lanes.clear();
+    }
+
+    [[nodiscard]] const std::string& QueueName() const {
+        return queueName;
+    }
+
+    // messages handled so far, for throughput reports
+    [[nodiscard]] uint64_t Processed() const {
+        return metrics::Registry::Instance().Total(metrics.processed);
+    }
+
+    // lag of the most recently delivered message
+    [[nodiscard]] std::chrono::milliseconds LastLag() const {
+        return std::chrono::milliseconds(lastLag.load(std::memory_order_relaxed));
+    }
+};
 
-#endif //COMMON_QUEUE_MESSAGE_CONSUMER_HPP
\ No newline at end of file
+#endif //COMMON_QUEUE_MESSAGE_CONSUMER_HPP
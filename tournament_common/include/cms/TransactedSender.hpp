@@ -0,0 +1,74 @@
+#ifndef COMMON_TRANSACTED_SENDER_HPP
+#define COMMON_TRANSACTED_SENDER_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <cms/Connection.h>
+#include <cms/MessageProducer.h>
+#include <cms/Session.h>
+#include <cms/TextMessage.h>
+
+#include "cms/ConnectionManager.hpp"
+#include "cms/IBatchSender.hpp"
+
+// IBatchSender on a transacted session with one producer per destination. Not thread safe, each
+// sending thread owns its own. After a CMSException call Reset(), the next Send() opens a new
+// session on the connection current at that time.
+class TransactedSender : public IBatchSender {
+    struct QueueProducer {
+        std::unique_ptr<cms::Destination> destination;
+        std::unique_ptr<cms::MessageProducer> producer;
+    };
+
+    std::shared_ptr<ConnectionManager> connectionManager;
+    cms::DeliveryMode::DELIVERY_MODE deliveryMode;
+    // destroyed bottom up: producers, then the session, then our reference to the connection
+    std::shared_ptr<cms::Connection> connection;
+    std::unique_ptr<cms::Session> session;
+    std::unordered_map<std::string, QueueProducer> producers;
+
+    cms::MessageProducer& ProducerFor(const std::string& queue) {
+        auto found = producers.find(queue);
+        if (found == producers.end()) {
+            QueueProducer queueProducer;
+            queueProducer.destination.reset(session->createQueue(queue));
+            queueProducer.producer.reset(session->createProducer(queueProducer.destination.get()));
+            queueProducer.producer->setDeliveryMode(deliveryMode);
+            found = producers.emplace(queue, std::move(queueProducer)).first;
+        }
+        return *found->second.producer;
+    }
+
+public:
+    explicit TransactedSender(std::shared_ptr<ConnectionManager> connectionManager,
+                              const cms::DeliveryMode::DELIVERY_MODE deliveryMode = cms::DeliveryMode::NON_PERSISTENT)
+        : connectionManager(std::move(connectionManager)), deliveryMode(deliveryMode) {}
+
+    TransactedSender(const TransactedSender&) = delete;
+    TransactedSender& operator=(const TransactedSender&) = delete;
+
+    void Send(const std::string& queue, const std::string& message) override {
+        if (!session) {
+            connection = connectionManager->Connection();
+            session.reset(connection->createSession(cms::Session::SESSION_TRANSACTED));
+        }
+        const auto brokerMessage = std::unique_ptr<cms::TextMessage>(session->createTextMessage(message));
+        ProducerFor(queue).send(brokerMessage.get());
+    }
+
+    void Commit() override {
+        if (session) {
+            session->commit();
+        }
+    }
+
+    void Reset() override {
+        producers.clear();
+        session.reset();
+        connection.reset();
+    }
+};
+
+#endif //COMMON_TRANSACTED_SENDER_HPP
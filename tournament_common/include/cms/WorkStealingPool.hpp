@@ -0,0 +1,167 @@
+#ifndef COMMON_WORK_STEALING_POOL_HPP
+#define COMMON_WORK_STEALING_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Threads with one task deque each. Tasks submitted from outside the pool (the consumer lanes)
+// are spread round robin over the deques, tasks submitted by a pool thread stay on its own deque.
+// A thread takes the oldest task of its own deque and, when that is empty, steals the newest task of
+// another one, so a slow handler on one thread does not hold back what was queued behind it.
+//
+// Threads with nothing to do park on a condition variable. Tasks still queued at destruction run
+// before the threads exit. Tasks must not throw.
+class WorkStealingPool {
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::unique_ptr<Worker[]> workers;
+    size_t workerCount;
+    std::atomic<size_t> nextWorker{0};
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> sleepers{0};
+    std::atomic<uint64_t> generation{0};
+    std::atomic<bool> stopping{false};
+    std::mutex parkMutex;
+    std::condition_variable parkCondition;
+    // declared last so the threads are joined before the deques are destroyed
+    std::vector<std::jthread> threads;
+
+    // index of the calling thread in the pool it belongs to
+    struct Current {
+        const WorkStealingPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    static Current& CurrentThread() {
+        thread_local Current current;
+        return current;
+    }
+
+    bool TakeOwn(const size_t index, std::function<void()>& task) {
+        Worker& worker = workers[index];
+        std::lock_guard lock(worker.mutex);
+        if (worker.tasks.empty()) {
+            return false;
+        }
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        return true;
+    }
+
+    bool Steal(const size_t thief, std::function<void()>& task) {
+        for (size_t offset = 1; offset < workerCount; offset++) {
+            Worker& victim = workers[(thief + offset) % workerCount];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Pairs with the sleepers increment in Park(): either the sleeper sees the task or we see the
+    // sleeper, a wake up is never lost.
+    void WakeOne() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) > 0) {
+            generation.fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard lock(parkMutex);
+            }
+            parkCondition.notify_one();
+        }
+    }
+
+    void Park() {
+        const uint64_t seen = generation.load(std::memory_order_relaxed);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        if (pending.load(std::memory_order_seq_cst) == 0 && !stopping.load(std::memory_order_relaxed)) {
+            std::unique_lock lock(parkMutex);
+            parkCondition.wait(lock, [&] {
+                return generation.load(std::memory_order_relaxed) != seen || stopping.load(std::memory_order_relaxed);
+            });
+        }
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void Run(const size_t index) {
+        CurrentThread() = {this, index};
+        std::function<void()> task;
+        while (true) {
+            if (TakeOwn(index, task) || Steal(index, task)) {
+                pending.fetch_sub(1, std::memory_order_relaxed);
+                task();
+                task = nullptr;
+                continue;
+            }
+            if (stopping.load(std::memory_order_acquire) && pending.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+            Park();
+        }
+    }
+
+public:
+    // 0 threads means one per hardware thread
+    explicit WorkStealingPool(size_t threadCount) {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workerCount = threadCount;
+        workers = std::make_unique<Worker[]>(threadCount);
+        threads.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; i++) {
+            threads.emplace_back([this, i] { Run(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        stopping.store(true, std::memory_order_seq_cst);
+        {
+            std::lock_guard lock(parkMutex);
+        }
+        parkCondition.notify_all();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void Submit(std::function<void()> task) {
+        const Current& current = CurrentThread();
+        const size_t index = current.pool == this
+                                 ? current.index
+                                 : nextWorker.fetch_add(1, std::memory_order_relaxed) % workerCount;
+        // counted before it is visible, a thread that takes it never sees pending go below zero
+        pending.fetch_add(1, std::memory_order_seq_cst);
+        {
+            std::lock_guard lock(workers[index].mutex);
+            workers[index].tasks.push_back(std::move(task));
+        }
+        WakeOne();
+    }
+
+    [[nodiscard]] size_t ThreadCount() const {
+        return workerCount;
+    }
+
+    // tasks queued and not started yet
+    [[nodiscard]] size_t Pending() const {
+        return pending.load(std::memory_order_relaxed);
+    }
+};
+
+#endif //COMMON_WORK_STEALING_POOL_HPP
@@ -1,15 +1,39 @@
 #ifndef DATA_BASE_CONFIGURATION_HPP
 #define DATA_BASE_CONFIGURATION_HPP
 
+#include <algorithm>
+#include <chrono>
 #include <string>
+#include <nlohmann/json.hpp>
 
 namespace config {
     struct DatabaseConfiguration{
         std::string connectionString;
+        size_t minPoolSize = 1;
+        size_t maxPoolSize = 1;
+        // live connections needed before the service reports ready
+        size_t readyPoolSize = 1;
+        std::chrono::milliseconds startupTimeout{30000};
+        // how long Connection() waits for a free connection before giving up
+        std::chrono::milliseconds acquireTimeout{5000};
+        // idle connections above minPoolSize are closed after this long
+        std::chrono::milliseconds idleTimeout{60000};
+        // idle connections older than this are pinged before being handed out
+        std::chrono::milliseconds validationInterval{30000};
     };
 
     inline void from_json(const nlohmann::json& json, DatabaseConfiguration& databaseConfiguration) {
         json.at("connectionString").get_to(databaseConfiguration.connectionString);
+
+        // "poolSize" is still accepted as a fixed size pool
+        const auto poolSize = json.value<size_t>("poolSize", 1);
+        databaseConfiguration.minPoolSize = json.value<size_t>("minPoolSize", poolSize);
+        databaseConfiguration.maxPoolSize = std::max(json.value<size_t>("maxPoolSize", poolSize), databaseConfiguration.minPoolSize);
+        databaseConfiguration.readyPoolSize = std::min(json.value<size_t>("readyPoolSize", 1), databaseConfiguration.minPoolSize);
+        databaseConfiguration.startupTimeout = std::chrono::milliseconds(json.value<int64_t>("startupTimeoutMs", 30000));
+        databaseConfiguration.acquireTimeout = std::chrono::milliseconds(json.value<int64_t>("acquireTimeoutMs", 5000));
+        databaseConfiguration.idleTimeout = std::chrono::milliseconds(json.value<int64_t>("idleTimeoutMs", 60000));
+        databaseConfiguration.validationInterval = std::chrono::milliseconds(json.value<int64_t>("validationIntervalMs", 30000));
     }
 }
 #endif
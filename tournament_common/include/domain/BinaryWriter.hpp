@@ -0,0 +1,220 @@
+#ifndef DOMAIN_BINARY_WRITER_HPP
+#define DOMAIN_BINARY_WRITER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "domain/Fields.hpp"
+
+// CBOR and MessagePack counterparts of JsonWriter.hpp, generated from the same field lists. Both
+// formats prefix maps and arrays with their size, so a domain object is written with one counting
+// pass over its OmitEmpty fields. Integers and lengths use the shortest encoding, as
+// nlohmann::json::to_cbor/to_msgpack do, so either side can decode what the other writes.
+namespace domain {
+    namespace binary {
+        inline void BigEndian(std::string& out, const uint64_t value, const int bytes) {
+            for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+                out.push_back(static_cast<char>(value >> shift & 0xFF));
+            }
+        }
+
+        struct Cbor {
+            static void Head(std::string& out, const uint8_t major, const uint64_t value) {
+                const auto type = static_cast<uint8_t>(major << 5);
+                if (value < 24) {
+                    out.push_back(static_cast<char>(type | value));
+                } else if (value <= UINT8_MAX) {
+                    out.push_back(static_cast<char>(type | 24));
+                    BigEndian(out, value, 1);
+                } else if (value <= UINT16_MAX) {
+                    out.push_back(static_cast<char>(type | 25));
+                    BigEndian(out, value, 2);
+                } else if (value <= UINT32_MAX) {
+                    out.push_back(static_cast<char>(type | 26));
+                    BigEndian(out, value, 4);
+                } else {
+                    out.push_back(static_cast<char>(type | 27));
+                    BigEndian(out, value, 8);
+                }
+            }
+
+            static void Integer(std::string& out, const int64_t value) {
+                if (value >= 0) {
+                    Head(out, 0, static_cast<uint64_t>(value));
+                } else {
+                    Head(out, 1, static_cast<uint64_t>(-1 - value));
+                }
+            }
+
+            static void String(std::string& out, const std::string_view value) {
+                Head(out, 3, value.size());
+                out.append(value);
+            }
+
+            static void Map(std::string& out, const size_t size) { Head(out, 5, size); }
+            static void Array(std::string& out, const size_t size) { Head(out, 4, size); }
+
+            // An array header with room for a 32 bit size, filled in by CloseArray() once the
+            // number of elements is known. Returns where the size goes.
+            static size_t OpenArray(std::string& out) {
+                out.push_back(static_cast<char>(4 << 5 | 26));
+                out.append(4, '\0');
+                return out.size() - 4;
+            }
+
+            static void CloseArray(std::string& out, const size_t position, const uint32_t size) {
+                for (int i = 0; i < 4; i++) {
+                    out[position + i] = static_cast<char>(size >> (24 - 8 * i) & 0xFF);
+                }
+            }
+        };
+
+        struct MessagePack {
+            static void Integer(std::string& out, const int64_t value) {
+                if (value >= 0) {
+                    if (value < 128) {
+                        out.push_back(static_cast<char>(value));
+                    } else if (value <= UINT8_MAX) {
+                        out.push_back(static_cast<char>(0xCC));
+                        BigEndian(out, value, 1);
+                    } else if (value <= UINT16_MAX) {
+                        out.push_back(static_cast<char>(0xCD));
+                        BigEndian(out, value, 2);
+                    } else if (value <= UINT32_MAX) {
+                        out.push_back(static_cast<char>(0xCE));
+                        BigEndian(out, value, 4);
+                    } else {
+                        out.push_back(static_cast<char>(0xCF));
+                        BigEndian(out, value, 8);
+                    }
+                } else if (value >= -32) {
+                    out.push_back(static_cast<char>(value));
+                } else if (value >= INT8_MIN) {
+                    out.push_back(static_cast<char>(0xD0));
+                    BigEndian(out, static_cast<uint64_t>(value), 1);
+                } else if (value >= INT16_MIN) {
+                    out.push_back(static_cast<char>(0xD1));
+                    BigEndian(out, static_cast<uint64_t>(value), 2);
+                } else if (value >= INT32_MIN) {
+                    out.push_back(static_cast<char>(0xD2));
+                    BigEndian(out, static_cast<uint64_t>(value), 4);
+                } else {
+                    out.push_back(static_cast<char>(0xD3));
+                    BigEndian(out, static_cast<uint64_t>(value), 8);
+                }
+            }
+
+            static void String(std::string& out, const std::string_view value) {
+                const size_t size = value.size();
+                if (size < 32) {
+                    out.push_back(static_cast<char>(0xA0 | size));
+                } else if (size <= UINT8_MAX) {
+                    out.push_back(static_cast<char>(0xD9));
+                    BigEndian(out, size, 1);
+                } else if (size <= UINT16_MAX) {
+                    out.push_back(static_cast<char>(0xDA));
+                    BigEndian(out, size, 2);
+                } else {
+                    out.push_back(static_cast<char>(0xDB));
+                    BigEndian(out, size, 4);
+                }
+                out.append(value);
+            }
+
+            static void Map(std::string& out, const size_t size) {
+                if (size < 16) {
+                    out.push_back(static_cast<char>(0x80 | size));
+                } else if (size <= UINT16_MAX) {
+                    out.push_back(static_cast<char>(0xDE));
+                    BigEndian(out, size, 2);
+                } else {
+                    out.push_back(static_cast<char>(0xDF));
+                    BigEndian(out, size, 4);
+                }
+            }
+
+            static void Array(std::string& out, const size_t size) {
+                if (size < 16) {
+                    out.push_back(static_cast<char>(0x90 | size));
+                } else if (size <= UINT16_MAX) {
+                    out.push_back(static_cast<char>(0xDC));
+                    BigEndian(out, size, 2);
+                } else {
+                    out.push_back(static_cast<char>(0xDD));
+                    BigEndian(out, size, 4);
+                }
+            }
+
+            // see Cbor::OpenArray
+            static size_t OpenArray(std::string& out) {
+                out.push_back(static_cast<char>(0xDD));
+                out.append(4, '\0');
+                return out.size() - 4;
+            }
+
+            static void CloseArray(std::string& out, const size_t position, const uint32_t size) {
+                for (int i = 0; i < 4; i++) {
+                    out[position + i] = static_cast<char>(size >> (24 - 8 * i) & 0xFF);
+                }
+            }
+        };
+
+        template<typename Codec>
+        void Write(std::string& out, const std::string& value) {
+            Codec::String(out, value);
+        }
+
+        template<typename Codec>
+        void Write(std::string& out, const int value) {
+            Codec::Integer(out, value);
+        }
+
+        template<typename Codec>
+        void Write(std::string& out, const TournamentType type) {
+            Codec::String(out, toString(type));
+        }
+
+        template<typename Codec, Described Type>
+        void Write(std::string& out, const Type& value);
+
+        template<typename Codec, Described Type>
+        void Write(std::string& out, const std::shared_ptr<Type>& value) {
+            Write<Codec>(out, *value);
+        }
+
+        template<typename Codec, typename Type>
+        void Write(std::string& out, const std::vector<Type>& items) {
+            Codec::Array(out, items.size());
+            for (const auto& item : items) {
+                Write<Codec>(out, item);
+            }
+        }
+
+        template<typename Field, typename Type>
+        bool Omitted(const Field& field, const Type& value) {
+            const auto& member = field.access(value);
+            if constexpr (requires { member.empty(); }) {
+                return field.flags & fields::OmitEmpty && member.empty();
+            }
+            return false;
+        }
+
+        template<typename Codec, Described Type>
+        void Write(std::string& out, const Type& value) {
+            size_t size = 0;
+            fields::ForEachField<Type>([&](const auto& field) { size += !Omitted(field, value); });
+            Codec::Map(out, size);
+            fields::ForEachField<Type>([&](const auto& field) {
+                if (!Omitted(field, value)) {
+                    Codec::String(out, field.key);
+                    Write<Codec>(out, field.access(value));
+                }
+            });
+        }
+    }
+}
+
+#endif //DOMAIN_BINARY_WRITER_HPP
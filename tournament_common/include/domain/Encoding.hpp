@@ -0,0 +1,88 @@
+#ifndef DOMAIN_ENCODING_HPP
+#define DOMAIN_ENCODING_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "domain/BinaryWriter.hpp"
+#include "domain/Format.hpp"
+#include "domain/JsonWriter.hpp"
+
+// Picks the writer for a wire format at run time, the writers themselves are all compile time generated.
+namespace domain {
+    template<typename Type>
+    void WriteEncoded(std::string& out, const Format format, const Type& value) {
+        switch (format) {
+            case Format::Cbor:
+                binary::Write<binary::Cbor>(out, value);
+                break;
+            case Format::MessagePack:
+                binary::Write<binary::MessagePack>(out, value);
+                break;
+            case Format::Json:
+            default:
+                WriteJson(out, value);
+        }
+    }
+
+    // Same thread local buffer scheme as ToJson().
+    template<typename Type>
+    std::string Encode(const Format format, const Type& value) {
+        if (format == Format::Json) {
+            return ToJson(value);
+        }
+        thread_local std::string buffer;
+        buffer.clear();
+        WriteEncoded(buffer, format, value);
+        return buffer;
+    }
+
+    // Writes a list whose length is only known at the end, for rows that are serialized as they
+    // are read. The binary formats reserve a 32 bit size in the array header and fill it in on Close().
+    class ListEncoder {
+        std::string& out;
+        Format format;
+        size_t sizePosition = 0;
+        uint32_t count = 0;
+
+    public:
+        ListEncoder(std::string& out, const Format format) : out(out), format(format) {
+            switch (format) {
+                case Format::Cbor:
+                    sizePosition = binary::Cbor::OpenArray(out);
+                    break;
+                case Format::MessagePack:
+                    sizePosition = binary::MessagePack::OpenArray(out);
+                    break;
+                case Format::Json:
+                default:
+                    out.push_back('[');
+            }
+        }
+
+        template<typename Type>
+        void Add(const Type& item) {
+            if (format == Format::Json && count > 0) {
+                out.push_back(',');
+            }
+            WriteEncoded(out, format, item);
+            ++count;
+        }
+
+        void Close() {
+            switch (format) {
+                case Format::Cbor:
+                    binary::Cbor::CloseArray(out, sizePosition, count);
+                    break;
+                case Format::MessagePack:
+                    binary::MessagePack::CloseArray(out, sizePosition, count);
+                    break;
+                case Format::Json:
+                default:
+                    out.push_back(']');
+            }
+        }
+    };
+}
+
+#endif //DOMAIN_ENCODING_HPP
@@ -0,0 +1,183 @@
+#ifndef DOMAIN_FIELDS_HPP
+#define DOMAIN_FIELDS_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "domain/Group.hpp"
+#include "domain/Team.hpp"
+#include "domain/Tournament.hpp"
+
+// Compile time description of the JSON shape of each domain type. The writer, the SAX decoder and
+// the nlohmann to_json/from_json overloads are all generated from these lists, so a field is
+// declared once and every path (responses, request bodies, database documents) agrees on it.
+namespace domain {
+    namespace fields {
+        enum Flags : unsigned {
+            None = 0,
+            // not written while the value is empty
+            OmitEmpty = 1,
+            // a value of the wrong type is ignored instead of rejected
+            SkipMismatch = 2
+        };
+
+        // access is a generic lambda returning a reference to the member, const or not as its argument.
+        template<typename Access>
+        struct Field {
+            std::string_view key;
+            Access access;
+            unsigned flags = None;
+        };
+
+        template<typename Access>
+        Field(std::string_view, Access, unsigned = None) -> Field<Access>;
+    }
+
+    // Specialized for every serializable type. Fields are listed in key order, which is also the
+    // order they are written in (the same order nlohmann::json, backed by a std::map, would use).
+    template<typename Type>
+    struct Describe;
+
+    template<typename Type>
+    concept Described = requires { Describe<Type>::fields; };
+
+    template<>
+    struct Describe<Team> {
+        static constexpr auto fields = std::make_tuple(
+            fields::Field{"id", [](auto& team) -> auto& { return team.Id; }, fields::OmitEmpty},
+            fields::Field{"name", [](auto& team) -> auto& { return team.Name; }}
+        );
+    };
+
+    // the const getters of TournamentFormat return by value, hence decltype(auto)
+    template<>
+    struct Describe<TournamentFormat> {
+        static constexpr auto fields = std::make_tuple(
+            fields::Field{"maxTeamsPerGroup", [](auto& format) -> decltype(auto) { return format.MaxTeamsPerGroup(); }},
+            fields::Field{"numberOfGroups", [](auto& format) -> decltype(auto) { return format.NumberOfGroups(); }},
+            fields::Field{"type", [](auto& format) -> decltype(auto) { return format.Type(); }}
+        );
+    };
+
+    template<>
+    struct Describe<Tournament> {
+        static constexpr auto fields = std::make_tuple(
+            fields::Field{"format", [](auto& tournament) -> auto& { return tournament.Format(); }},
+            fields::Field{"id", [](auto& tournament) -> auto& { return tournament.Id(); }, fields::OmitEmpty},
+            fields::Field{"name", [](auto& tournament) -> auto& { return tournament.Name(); }}
+        );
+    };
+
+    template<>
+    struct Describe<Group> {
+        static constexpr auto fields = std::make_tuple(
+            fields::Field{"id", [](auto& group) -> auto& { return group.Id(); }, fields::OmitEmpty},
+            fields::Field{"name", [](auto& group) -> auto& { return group.Name(); }},
+            // anything but an array of teams has always been ignored here
+            fields::Field{"teams", [](auto& group) -> auto& { return group.Teams(); }, fields::SkipMismatch},
+            fields::Field{"tournamentId", [](auto& group) -> auto& { return group.TournamentId(); }}
+        );
+    };
+
+    namespace fields {
+        template<typename Type>
+        inline constexpr size_t Count = std::tuple_size_v<std::remove_const_t<decltype(Describe<Type>::fields)>>;
+
+        template<typename Type>
+        inline constexpr auto Keys = std::apply([](const auto&... field) {
+            return std::array<std::string_view, sizeof...(field)>{field.key...};
+        }, Describe<Type>::fields);
+
+        constexpr uint32_t Hash(const std::string_view key, const uint32_t seed) {
+            uint32_t hash = 2166136261u ^ seed;
+            for (const char c : key) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+            }
+            return hash;
+        }
+
+        // Key lookup without probing: the seed is searched at compile time so that every key of the
+        // type lands in its own slot, a lookup is one hash and one string comparison.
+        template<typename Type>
+        class KeyTable {
+            static constexpr size_t Size = std::bit_ceil(Count<Type> * 2);
+            static constexpr uint8_t Empty = 0xFF;
+
+            static constexpr std::array<uint8_t, Size> Fill(const uint32_t seed) {
+                std::array<uint8_t, Size> slots{};
+                slots.fill(Empty);
+                for (size_t i = 0; i < Count<Type>; i++) {
+                    auto& slot = slots[Hash(Keys<Type>[i], seed) & (Size - 1)];
+                    if (slot != Empty) {
+                        slots.fill(Empty);
+                        return slots;
+                    }
+                    slot = static_cast<uint8_t>(i);
+                }
+                return slots;
+            }
+
+            static constexpr uint32_t FindSeed() {
+                for (uint32_t seed = 0; seed < 100000; seed++) {
+                    const auto slots = Fill(seed);
+                    if (Count<Type> == 0 || slots[Hash(Keys<Type>[0], seed) & (Size - 1)] != Empty) {
+                        return seed;
+                    }
+                }
+                return UINT32_MAX;
+            }
+
+            static constexpr uint32_t Seed = FindSeed();
+            static_assert(Seed != UINT32_MAX, "no perfect hash seed for these keys");
+            static constexpr auto Slots = Fill(Seed);
+
+            static constexpr bool Sorted() {
+                for (size_t i = 1; i < Count<Type>; i++) {
+                    if (!(Keys<Type>[i - 1] < Keys<Type>[i])) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            static_assert(Sorted(), "fields must be listed in key order");
+
+        public:
+            // index of the field in Describe<Type>::fields, or -1 for a key the type does not have
+            static constexpr int Find(const std::string_view key) {
+                const uint8_t index = Slots[Hash(key, Seed) & (Size - 1)];
+                return index != Empty && Keys<Type>[index] == key ? index : -1;
+            }
+        };
+
+        // Calls visit with the field at a runtime index, the fold compiles down to a switch.
+        template<typename Type, typename Visit>
+        constexpr void VisitField(const int index, Visit&& visit) {
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (void) ((I == static_cast<size_t>(index) ? (visit(std::get<I>(Describe<Type>::fields)), true) : false) || ...);
+            }(std::make_index_sequence<Count<Type>>{});
+        }
+
+        template<typename Type, typename Visit>
+        constexpr void ForEachField(Visit&& visit) {
+            std::apply([&](const auto&... field) { (visit(field), ...); }, Describe<Type>::fields);
+        }
+
+        // "key": as it appears in the output, built once at compile time
+        template<typename Type, size_t Index>
+        inline constexpr auto QuotedKey = [] {
+            constexpr std::string_view key = Keys<Type>[Index];
+            std::array<char, key.size() + 3> quoted{};
+            quoted[0] = '"';
+            key.copy(quoted.data() + 1, key.size());
+            quoted[key.size() + 1] = '"';
+            quoted[key.size() + 2] = ':';
+            return quoted;
+        }();
+    }
+}
+
+#endif //DOMAIN_FIELDS_HPP
@@ -0,0 +1,25 @@
+#ifndef DOMAIN_FORMAT_HPP
+#define DOMAIN_FORMAT_HPP
+
+#include <string_view>
+
+namespace domain {
+    // Wire formats the domain objects can be encoded in and decoded from.
+    enum class Format {
+        Json, Cbor, MessagePack
+    };
+
+    inline std::string_view ContentType(const Format format) {
+        switch (format) {
+            case Format::Cbor:
+                return "application/cbor";
+            case Format::MessagePack:
+                return "application/msgpack";
+            case Format::Json:
+            default:
+                return "application/json";
+        }
+    }
+}
+
+#endif //DOMAIN_FORMAT_HPP
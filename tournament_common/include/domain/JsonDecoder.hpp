@@ -0,0 +1,318 @@
+#ifndef DOMAIN_JSON_DECODER_HPP
+#define DOMAIN_JSON_DECODER_HPP
+
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "domain/Fields.hpp"
+#include "domain/Format.hpp"
+
+// Request body decoding in a single pass: the SAX events of the parser are written straight into the
+// domain object, so the body is tokenized once and no nlohmann::json DOM is built. Members are found
+// through the key tables generated from Fields.hpp, unknown members are skipped. nlohmann's CBOR and
+// MessagePack parsers produce the same events, so the binary formats share the decoder.
+namespace domain {
+    struct DecodeError {
+        // byte offset of a syntax error, 0 for errors about the content
+        size_t offset = 0;
+        // JSON pointer of the offending field, empty for syntax errors
+        std::string pointer;
+        std::string message;
+
+        [[nodiscard]] std::string Describe() const {
+            if (pointer.empty()) {
+                return std::format("Invalid JSON at byte {}: {}", offset, message);
+            }
+            return std::format("Invalid field {}: {}", pointer, message);
+        }
+    };
+
+    template<typename Type>
+    using Decoded = std::expected<Type, DecodeError>;
+
+    namespace decoding {
+        enum class Kind { String, Integer, Float, Boolean, Null, Object, Array };
+
+        // What happens to a value: taken (containers are entered), ignored with all its content,
+        // or rejected because it has the wrong type.
+        enum class Verdict { Take, Skip, Reject };
+
+        struct Event {
+            Kind kind;
+            const std::string* text;
+            int64_t number;
+        };
+
+        // An object or array being filled. accept() receives each of its values, for an object the
+        // member key is passed along. When a container value is taken, accept() sets up child for it.
+        struct Sink {
+            void* target = nullptr;
+            Verdict (*accept)(void* target, std::string_view key, const Event& event, Sink& child, const char*& expected) = nullptr;
+        };
+
+        inline Verdict Accept(std::string& value, const Event& event, Sink&, const char*& expected) {
+            expected = "a string";
+            if (event.kind != Kind::String) return Verdict::Reject;
+            value = *event.text;
+            return Verdict::Take;
+        }
+
+        inline Verdict Accept(int& value, const Event& event, Sink&, const char*& expected) {
+            expected = "an integer";
+            if (event.kind != Kind::Integer || event.number < std::numeric_limits<int>::min() || event.number > std::numeric_limits<int>::max()) {
+                return Verdict::Reject;
+            }
+            value = static_cast<int>(event.number);
+            return Verdict::Take;
+        }
+
+        inline Verdict Accept(TournamentType& value, const Event& event, Sink&, const char*& expected) {
+            expected = "a string";
+            if (event.kind != Kind::String) return Verdict::Reject;
+            value = fromString(*event.text);
+            return Verdict::Take;
+        }
+
+        template<Described Type>
+        Verdict Accept(Type& value, const Event& event, Sink& child, const char*& expected);
+
+        template<typename Type>
+        Verdict Accept(std::vector<Type>& value, const Event& event, Sink& child, const char*& expected);
+
+        template<Described Type>
+        Verdict AcceptMember(void* target, const std::string_view key, const Event& event, Sink& child, const char*& expected) {
+            const int index = fields::KeyTable<Type>::Find(key);
+            if (index < 0) {
+                return Verdict::Skip;
+            }
+            Verdict verdict = Verdict::Skip;
+            fields::VisitField<Type>(index, [&](const auto& field) {
+                verdict = Accept(field.access(*static_cast<Type*>(target)), event, child, expected);
+                if (verdict == Verdict::Reject && field.flags & fields::SkipMismatch) {
+                    verdict = Verdict::Skip;
+                }
+            });
+            return verdict;
+        }
+
+        template<Described Type>
+        Verdict Accept(Type& value, const Event& event, Sink& child, const char*& expected) {
+            expected = "an object";
+            if (event.kind != Kind::Object) return Verdict::Reject;
+            child = {&value, AcceptMember<Type>};
+            return Verdict::Take;
+        }
+
+        template<typename Type>
+        Verdict AcceptElement(void* target, std::string_view, const Event& event, Sink& child, const char*& expected) {
+            auto& items = *static_cast<std::vector<Type>*>(target);
+            items.emplace_back();
+            const Verdict verdict = Accept(items.back(), event, child, expected);
+            if (verdict != Verdict::Take) {
+                items.pop_back();
+            }
+            return verdict;
+        }
+
+        template<typename Type>
+        Verdict Accept(std::vector<Type>& value, const Event& event, Sink& child, const char*& expected) {
+            expected = "an array";
+            if (event.kind != Kind::Array) return Verdict::Reject;
+            child = {&value, AcceptElement<Type>};
+            return Verdict::Take;
+        }
+
+        // Drives the sinks from the parser events, keeps track of the position for error pointers
+        // and skips the content of ignored containers.
+        template<typename Type>
+        class Decoder final : public nlohmann::json_sax<nlohmann::json> {
+            struct Frame {
+                Sink sink;
+                bool array = false;
+                size_t index = 0;
+                std::string key;
+            };
+            std::vector<Frame> frames;
+            size_t active = 0;
+            size_t skipping = 0;
+            DecodeError error;
+
+            bool Dispatch(const Event& event) {
+                const bool container = event.kind == Kind::Object || event.kind == Kind::Array;
+                if (skipping > 0) {
+                    skipping += container;
+                    return true;
+                }
+
+                Sink child;
+                const char* expected = "";
+                const Verdict verdict = active == 0
+                                            ? Accept(value, event, child, expected)
+                                            : frames[active - 1].sink.accept(frames[active - 1].sink.target, frames[active - 1].key, event, child, expected);
+                switch (verdict) {
+                    case Verdict::Reject:
+                        error.pointer = Pointer();
+                        error.message = std::format("expected {}", expected);
+                        return false;
+                    case Verdict::Skip:
+                        if (container) {
+                            skipping = 1;
+                        } else {
+                            Advance();
+                        }
+                        return true;
+                    case Verdict::Take:
+                        if (container) {
+                            if (active == frames.size()) {
+                                frames.emplace_back();
+                            }
+                            auto& frame = frames[active++];
+                            frame.sink = child;
+                            frame.array = event.kind == Kind::Array;
+                            frame.index = 0;
+                            frame.key.clear();
+                        } else {
+                            Advance();
+                        }
+                        return true;
+                }
+                return false;
+            }
+
+            bool End() {
+                if (skipping > 0) {
+                    if (--skipping == 0) {
+                        Advance();
+                    }
+                    return true;
+                }
+                --active;
+                Advance();
+                return true;
+            }
+
+            void Advance() {
+                if (active > 0 && frames[active - 1].array) {
+                    ++frames[active - 1].index;
+                }
+            }
+
+            [[nodiscard]] std::string Pointer() const {
+                std::string pointer;
+                for (size_t i = 0; i < active; i++) {
+                    pointer.push_back('/');
+                    pointer += frames[i].array ? std::to_string(frames[i].index) : frames[i].key;
+                }
+                return pointer.empty() ? "/" : pointer;
+            }
+
+        public:
+            Type value{};
+
+            [[nodiscard]] const DecodeError& Error() const { return error; }
+
+            bool null() override { return Dispatch({Kind::Null, nullptr, 0}); }
+            bool boolean(bool) override { return Dispatch({Kind::Boolean, nullptr, 0}); }
+            bool number_integer(const number_integer_t number) override { return Dispatch({Kind::Integer, nullptr, number}); }
+            bool number_unsigned(const number_unsigned_t number) override {
+                if (number > static_cast<number_unsigned_t>(std::numeric_limits<int64_t>::max())) {
+                    return Dispatch({Kind::Float, nullptr, 0});
+                }
+                return Dispatch({Kind::Integer, nullptr, static_cast<int64_t>(number)});
+            }
+            bool number_float(number_float_t, const string_t&) override { return Dispatch({Kind::Float, nullptr, 0}); }
+            bool string(string_t& text) override { return Dispatch({Kind::String, &text, 0}); }
+            bool binary(binary_t&) override { return Dispatch({Kind::Null, nullptr, 0}); }
+            bool start_object(std::size_t) override { return Dispatch({Kind::Object, nullptr, 0}); }
+            bool end_object() override { return End(); }
+            bool start_array(std::size_t) override { return Dispatch({Kind::Array, nullptr, 0}); }
+            bool end_array() override { return End(); }
+            bool key(string_t& text) override {
+                if (skipping == 0) {
+                    frames[active - 1].key = text;
+                }
+                return true;
+            }
+            bool parse_error(const std::size_t position, const std::string&, const nlohmann::json::exception& ex) override {
+                error.offset = position;
+                error.pointer.clear();
+                error.message = ex.what();
+                return false;
+            }
+        };
+
+        inline DecodeError MissingName(std::string pointer) {
+            return {0, std::move(pointer), "missing required field"};
+        }
+    }
+
+    // Any type with a field list in Fields.hpp, or a vector of them.
+    template<typename Type>
+    Decoded<Type> Decode(const std::string_view body, const Format format = Format::Json) {
+        static constexpr nlohmann::json::input_format_t InputFormats[] = {
+            nlohmann::json::input_format_t::json, nlohmann::json::input_format_t::cbor, nlohmann::json::input_format_t::msgpack
+        };
+        decoding::Decoder<Type> decoder;
+        if (!nlohmann::json::sax_parse(body, &decoder, InputFormats[static_cast<size_t>(format)])) {
+            return std::unexpected(decoder.Error());
+        }
+        return std::move(decoder.value);
+    }
+
+    // Documents read back from the database were written by WriteJson, failing to decode one means
+    // the row is corrupt.
+    template<typename Type>
+    Type FromDocument(const std::string_view document) {
+        auto decoded = Decode<Type>(document);
+        if (!decoded) {
+            throw std::runtime_error(std::format("corrupt document: {}", decoded.error().Describe()));
+        }
+        return std::move(*decoded);
+    }
+
+    inline Decoded<Team> DecodeTeam(const std::string_view body, const Format format = Format::Json) {
+        auto team = Decode<Team>(body, format);
+        if (team && team->Name.empty()) {
+            return std::unexpected(decoding::MissingName("/name"));
+        }
+        return team;
+    }
+
+    // An array of teams. With requireName every element needs a name, otherwise either field may be left out.
+    inline Decoded<std::vector<Team>> DecodeTeams(const std::string_view body, const bool requireName, const Format format = Format::Json) {
+        auto teams = Decode<std::vector<Team>>(body, format);
+        if (teams && requireName) {
+            for (size_t i = 0; i < teams->size(); i++) {
+                if ((*teams)[i].Name.empty()) {
+                    return std::unexpected(decoding::MissingName(std::format("/{}/name", i)));
+                }
+            }
+        }
+        return teams;
+    }
+
+    inline Decoded<Group> DecodeGroup(const std::string_view body, const Format format = Format::Json) {
+        auto group = Decode<Group>(body, format);
+        if (group && group->Name().empty()) {
+            return std::unexpected(decoding::MissingName("/name"));
+        }
+        return group;
+    }
+
+    inline Decoded<Tournament> DecodeTournament(const std::string_view body, const Format format = Format::Json) {
+        auto tournament = Decode<Tournament>(body, format);
+        if (tournament && tournament->Name().empty()) {
+            return std::unexpected(decoding::MissingName("/name"));
+        }
+        return tournament;
+    }
+}
+
+#endif //DOMAIN_JSON_DECODER_HPP
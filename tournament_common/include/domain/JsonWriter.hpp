@@ -0,0 +1,130 @@
+#ifndef DOMAIN_JSON_WRITER_HPP
+#define DOMAIN_JSON_WRITER_HPP
+
+#include <charconv>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "domain/Fields.hpp"
+
+// Writes domain objects as JSON text straight into a string, without building a nlohmann::json tree.
+// The output is byte for byte what dump() gives for the to_json overloads in Utilities.hpp: no
+// whitespace and keys in alphabetical order, the order of the field lists in Fields.hpp.
+//
+// Strings are not checked for valid UTF-8 (dump() would throw); everything written here comes from
+// jsonb columns or from bodies the parser already validated.
+namespace domain {
+    namespace writer {
+        // Runs of characters that need no escaping are appended in one go.
+        inline void String(std::string& out, const std::string_view value) {
+            static constexpr char Hex[] = "0123456789abcdef";
+            out.push_back('"');
+            size_t run = 0;
+            for (size_t i = 0; i < value.size(); i++) {
+                const auto c = static_cast<unsigned char>(value[i]);
+                if (c >= 0x20 && c != '"' && c != '\\') {
+                    continue;
+                }
+                out.append(value.data() + run, i - run);
+                run = i + 1;
+                out.push_back('\\');
+                switch (c) {
+                    case '"': out.push_back('"'); break;
+                    case '\\': out.push_back('\\'); break;
+                    case '\b': out.push_back('b'); break;
+                    case '\f': out.push_back('f'); break;
+                    case '\n': out.push_back('n'); break;
+                    case '\r': out.push_back('r'); break;
+                    case '\t': out.push_back('t'); break;
+                    default:
+                        out.append("u00");
+                        out.push_back(Hex[c >> 4]);
+                        out.push_back(Hex[c & 0xF]);
+                }
+            }
+            out.append(value.data() + run, value.size() - run);
+            out.push_back('"');
+        }
+
+        inline void Integer(std::string& out, const int value) {
+            char digits[16];
+            const auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+            out.append(digits, end);
+        }
+
+    }
+
+    inline void WriteJson(std::string& out, const std::string& value) {
+        writer::String(out, value);
+    }
+
+    inline void WriteJson(std::string& out, const int value) {
+        writer::Integer(out, value);
+    }
+
+    inline void WriteJson(std::string& out, const TournamentType type) {
+        writer::String(out, toString(type));
+    }
+
+    template<typename Type>
+    void WriteJson(std::string& out, const std::vector<Type>& items);
+
+    template<Described Type, size_t Index>
+    void WriteMember(std::string& out, const Type& value, bool& first) {
+        const auto& field = std::get<Index>(Describe<Type>::fields);
+        const auto& member = field.access(value);
+        if constexpr (requires { member.empty(); }) {
+            if (field.flags & fields::OmitEmpty && member.empty()) {
+                return;
+            }
+        }
+        if (!first) {
+            out.push_back(',');
+        }
+        first = false;
+        constexpr auto& key = fields::QuotedKey<Type, Index>;
+        out.append(key.data(), key.size());
+        WriteJson(out, member);
+    }
+
+    template<Described Type>
+    void WriteJson(std::string& out, const Type& value) {
+        out.push_back('{');
+        bool first = true;
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (WriteMember<Type, I>(out, value, first), ...);
+        }(std::make_index_sequence<fields::Count<Type>>{});
+        out.push_back('}');
+    }
+
+    template<Described Type>
+    void WriteJson(std::string& out, const std::shared_ptr<Type>& value) {
+        WriteJson(out, *value);
+    }
+
+    template<typename Type>
+    void WriteJson(std::string& out, const std::vector<Type>& items) {
+        out.push_back('[');
+        for (size_t i = 0; i < items.size(); i++) {
+            if (i > 0) {
+                out.push_back(',');
+            }
+            WriteJson(out, items[i]);
+        }
+        out.push_back(']');
+    }
+
+    // Serializes into a buffer owned by the calling thread and returns a copy of exactly the written
+    // size. The buffer keeps its capacity, so after the first few responses writing never reallocates.
+    template<typename Type>
+    std::string ToJson(const Type& value) {
+        thread_local std::string buffer;
+        buffer.clear();
+        WriteJson(buffer, value);
+        return buffer;
+    }
+}
+
+#endif //DOMAIN_JSON_WRITER_HPP
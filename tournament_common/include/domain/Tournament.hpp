@@ -2,6 +2,7 @@
 #define DOMAIN_TOURNAMENT_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "domain/Group.hpp"
@@ -12,6 +13,25 @@ namespace domain {
         ROUND_ROBIN, NFL
     };
 
+    inline TournamentType fromString(std::string_view type) {
+        if (type == "ROUND_ROBIN")
+            return TournamentType::ROUND_ROBIN;
+        if (type == "NFL")
+            return TournamentType::NFL;
+
+        return TournamentType::ROUND_ROBIN;
+    }
+
+    inline std::string_view toString(const TournamentType type) {
+        switch (type) {
+            case TournamentType::NFL:
+                return "NFL";
+            case TournamentType::ROUND_ROBIN:
+            default:
+                return "ROUND_ROBIN";
+        }
+    }
+
     class TournamentFormat {
         int numberOfGroups;
         int maxTeamsPerGroup;
@@ -61,7 +81,7 @@ namespace domain {
             this->format = format;
         }
 
-        [[nodiscard]] std::string Id() const {
+        [[nodiscard]] const std::string& Id() const {
             return this->id;
         }
 
@@ -69,7 +89,7 @@ namespace domain {
             return this->id;
         }
 
-        [[nodiscard]] std::string Name() const {
+        [[nodiscard]] const std::string& Name() const {
             return this->name;
         }
 
@@ -77,7 +97,7 @@ namespace domain {
             return this->name;
         }
 
-        [[nodiscard]] TournamentFormat Format() const {
+        [[nodiscard]] const TournamentFormat& Format() const {
             return this->format;
         }
 
@@ -1,159 +1,90 @@
 #ifndef DOMAIN_UTILITIES_HPP
 #define DOMAIN_UTILITIES_HPP
 
+#include <memory>
+#include <ranges>
+#include <string>
+#include <type_traits>
 #include <nlohmann/json.hpp>
+#include "domain/Fields.hpp"
 #include "domain/Team.hpp"
 #include "domain/Tournament.hpp"
 #include "domain/Group.hpp"
 #include "domain/Match.hpp"
 
+// nlohmann::json conversions, generated from the field lists in Fields.hpp. The service itself
+// writes and reads JSON with JsonWriter.hpp/JsonDecoder.hpp, these keep nlohmann::json(x) and
+// json.get<T>() working for everything else.
 namespace domain {
 
-    inline void to_json(nlohmann::json& json, const Team& team) {
-        json = {{"id", team.Id}, {"name", team.Name}};
+    inline void to_json(nlohmann::json& json, const TournamentType type) {
+        json = toString(type);
     }
 
-    inline void from_json(const nlohmann::json& json, Team& team) {
-        if(json.contains("id")) {
-            json.at("id").get_to(team.Id);
-        }
-        json.at("name").get_to(team.Name);
+    inline void from_json(const nlohmann::json& json, TournamentType& type) {
+        type = fromString(json.get<std::string>());
     }
 
-    inline void from_json(const nlohmann::json& json, std::vector<Team>& teams) {
-        for (auto j = json.begin(); j != json.end(); ++j) {
-            Team team;
-            if(j.value().contains("id")) {
-                j.value().at("id").get_to(team.Id);
-            }
-            if(j.value().contains("name")) {
-                j.value().at("name").get_to(team.Name);
+    template<Described Type>
+    void to_json(nlohmann::json& json, const Type& value) {
+        json = nlohmann::json::object();
+        fields::ForEachField<Type>([&](const auto& field) {
+            const auto& member = field.access(value);
+            if constexpr (requires { member.empty(); }) {
+                if (field.flags & fields::OmitEmpty && member.empty()) {
+                    return;
+                }
             }
-            teams.push_back(team);
-        }
-    }
-
-    inline void to_json(nlohmann::json& json, const std::shared_ptr<Team>& team) {
-        json = nlohmann::basic_json();
-        json["name"] = team->Name;
-
-        if (!team->Id.empty()) {
-            json["id"] = team->Id;
-        }
-    }
-
-    inline TournamentType fromString(std::string_view type) {
-        if (type == "ROUND_ROBIN")
-            return TournamentType::ROUND_ROBIN;
-        if (type == "NFL")
-            return TournamentType::NFL;
-
-        return TournamentType::ROUND_ROBIN;
-    }
-
-    inline void from_json(const nlohmann::json& json, TournamentFormat& format) {
-        if(json.contains("maxTeamsPerGroup"))
-            json.at("maxTeamsPerGroup").get_to(format.MaxTeamsPerGroup());
-        if(json.contains("numberOfGroups"))
-            json.at("numberOfGroups").get_to(format.NumberOfGroups());
-        if(json.contains("type"))
-            format.Type() = fromString(json["type"].get<std::string>());
-    }
-
-    inline void to_json(nlohmann::json& json, const TournamentFormat& format) {
-        json = {{"maxTeamsPerGroup", format.MaxTeamsPerGroup()}, {"numberOfGroups", format.NumberOfGroups()}};
-        switch (format.Type()) {
-            case TournamentType::ROUND_ROBIN:
-                json["type"] = "ROUND_ROBIN";
-                break;
-            case TournamentType::NFL:
-                json["type"] = "NFL";
-                break;
-            default:
-                json["type"] = "ROUND_ROBIN";
-        }
-    }
-
-    inline void to_json(nlohmann::json& json, const std::shared_ptr<Tournament>& tournament) {
-        json = {{"name", tournament->Name()}};
-        if (!tournament->Id().empty()) {
-            json["id"] = tournament->Id();
-        }
-        json["format"] = tournament->Format();
+            json[field.key] = member;
+        });
     }
 
-    inline void from_json(const nlohmann::json& json, std::shared_ptr<Tournament>& tournament) {
-        if(json.contains("id")) {
-            tournament->Id() = json["id"].get<std::string>();
+    // Whether json has the kind a member of type Value is read from, checked without building a json
+    // from the member.
+    template<typename Value>
+    bool MatchesJsonType(const nlohmann::json& json) {
+        if constexpr (std::is_same_v<Value, std::string>) {
+            return json.is_string();
+        } else if constexpr (std::is_same_v<Value, bool>) {
+            return json.is_boolean();
+        } else if constexpr (std::is_arithmetic_v<Value>) {
+            return json.is_number();
+        } else if constexpr (Described<Value>) {
+            return json.is_object();
+        } else if constexpr (std::ranges::range<Value>) {
+            return json.is_array();
+        } else {
+            return true;
         }
-        json["name"].get_to(tournament->Name());
-        if (json.contains("format"))
-            json.at("format").get_to(tournament->Format());
     }
 
-    inline void to_json(nlohmann::json& json, const Tournament& tournament) {
-        json = {{"name", tournament.Name()}};
-        if (!tournament.Id().empty()) {
-            json["id"] = tournament.Id();
-        }
-        json["format"] = tournament.Format();
-    }
-
-    inline void from_json(const nlohmann::json& json, Tournament& tournament) {
-        if(json.contains("id")) {
-            tournament.Id() = json["id"].get<std::string>();
-        }
-        json["name"].get_to(tournament.Name());
-        if (json.contains("format"))
-            json.at("format").get_to(tournament.Format());
-    }
-
-    inline void from_json(const nlohmann::json& json, Group& group) {
-        if(json.contains("id")) {
-            group.Id() = json["id"].get<std::string>();
-        }
-        if(json.contains("tournamentId")) {
-            group.TournamentId() = json["tournamentId"].get<std::string>();
-        }
-        json["name"].get_to(group.Name());
-
-//si no contiene un arreglo de teams, saltartelo
-        if (auto it = json.find("teams"); it != json.end() && it->is_array()) {
-            it->get_to(group.Teams());
-        }
-
-    }
-
-    inline void to_json(nlohmann::json& json, const std::shared_ptr<Group>& group) {
-        json["name"] = group->Name();
-        json["tournamentId"] = group->TournamentId();
-        if (!group->Id().empty()) {
-            json["id"] = group->Id();
+    // Walks the object once and finds each member's field through the key table, unknown keys are skipped.
+    template<Described Type>
+    void from_json(const nlohmann::json& json, Type& value) {
+        for (const auto& [key, member] : json.items()) {
+            const int index = fields::KeyTable<Type>::Find(key);
+            if (index < 0) {
+                continue;
+            }
+            fields::VisitField<Type>(index, [&](const auto& field) {
+                auto& target = field.access(value);
+                if (field.flags & fields::SkipMismatch && !MatchesJsonType<std::remove_cvref_t<decltype(target)>>(member)) {
+                    return;
+                }
+                member.get_to(target);
+            });
         }
-        json["teams"] = group->Teams();
     }
 
-    inline void to_json(nlohmann::json& json, const std::vector<std::shared_ptr<Group>>& groups) {
-        json = nlohmann::json::array();
-        for (const auto& group : groups) {
-            auto jsonGroup = nlohmann::json();
-            jsonGroup["name"] = group->Name();
-            jsonGroup["tournamentId"] = group->TournamentId();
-            if (!group->Id().empty()) {
-                jsonGroup["id"] = group->Id();
-            }
-            jsonGroup["teams"] = group->Teams();
-            json.push_back(jsonGroup);
-        }
+    template<Described Type>
+    void to_json(nlohmann::json& json, const std::shared_ptr<Type>& value) {
+        to_json(json, *value);
     }
 
-    inline void to_json(nlohmann::json& json, const Group& group) {
-        json["name"] = group.Name();
-        json["tournamentId"] = group.TournamentId();
-        if (!group.Id().empty()) {
-            json["id"] = group.Id();
-        }
-        json["teams"] = group.Teams();
+    template<Described Type>
+    void from_json(const nlohmann::json& json, std::shared_ptr<Type>& value) {
+        value = std::make_shared<Type>();
+        from_json(json, *value);
     }
 }
 
@@ -0,0 +1,146 @@
+#ifndef DOMAIN_UUID_HPP
+#define DOMAIN_UUID_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// 16 byte UUID, the type of every id column. Parsing and formatting work on 8 hex digits at a time
+// inside a 64 bit word (SWAR) instead of a character loop or a regex. Ids are bound to statements
+// in the binary form, which Postgres reads with uuid_recv instead of parsing text again.
+namespace domain {
+    namespace uuid {
+        inline constexpr uint64_t Ones = 0x0101010101010101ull;
+        inline constexpr uint64_t High = 0x8080808080808080ull;
+
+        // 0x80 in every byte strictly between low and high (both at most 128), see "Determine if a
+        // word has a byte between m and n" in Bit Twiddling Hacks.
+        constexpr uint64_t Between(const uint64_t word, const uint64_t low, const uint64_t high) {
+            const uint64_t low7 = word & ~High;
+            return (Ones * (127 + high) - low7) & ~word & (low7 + Ones * (127 - low)) & High;
+        }
+
+        inline uint64_t Load(const char* text) {
+            uint64_t word;
+            std::memcpy(&word, text, 8);
+            return word;
+        }
+
+        inline uint32_t Load4(const char* text) {
+            uint32_t word;
+            std::memcpy(&word, text, 4);
+            return word;
+        }
+
+        // Eight hex digits, first digit in the lowest byte, to the four bytes they spell (first byte
+        // lowest). False if any of them is not a hex digit.
+        inline bool Decode(const uint64_t digits, uint32_t& bytes) {
+            const uint64_t lower = digits | Ones * 0x20;
+            const uint64_t decimal = Between(digits, '0' - 1, '9' + 1);
+            const uint64_t letter = Between(lower, 'a' - 1, 'f' + 1);
+            if ((decimal | letter) != High) {
+                return false;
+            }
+            // the low nibble is the value of '0'..'9', for 'a'..'f' it is 1..6 and needs 9 more
+            uint64_t nibbles = (lower & Ones * 0x0F) + (letter >> 7) * 9;
+            // pair up the digits of each byte, then pack the four bytes together
+            nibbles = ((nibbles & 0x000F000F000F000Full) << 4) | ((nibbles >> 8) & 0x000F000F000F000Full);
+            nibbles = (nibbles | (nibbles >> 8)) & 0x0000FFFF0000FFFFull;
+            bytes = static_cast<uint32_t>(nibbles | (nibbles >> 16));
+            return true;
+        }
+
+        // Inverse of Decode, lowercase digits.
+        inline uint64_t Encode(const uint32_t bytes) {
+            uint64_t word = bytes;
+            word = (word | (word << 16)) & 0x0000FFFF0000FFFFull;
+            word = (word | (word << 8)) & 0x00FF00FF00FF00FFull;
+            const uint64_t nibbles = ((word >> 4) & 0x000F000F000F000Full) | ((word & 0x000F000F000F000Full) << 8);
+            // '0' + n, plus the distance from ':' to 'a' where n is 10 or more
+            return nibbles + Ones * '0' + (((nibbles + Ones * 6) >> 4) & Ones) * ('a' - '9' - 1);
+        }
+    }
+
+    class Uuid {
+        std::array<std::byte, 16> bytes{};
+
+    public:
+        static constexpr size_t TextSize = 36;
+
+        Uuid() = default;
+
+        // Canonical 8-4-4-4-12 form, either case. Anything else (braces, missing dashes) is rejected.
+        static std::optional<Uuid> Parse(const std::string_view text) {
+            static_assert(std::endian::native == std::endian::little, "the SWAR parser assumes a little endian target");
+            if (text.size() != TextSize || text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-') {
+                return std::nullopt;
+            }
+            // the 32 digits as four words of 8, the middle two joined across a dash
+            const uint64_t words[4] = {
+                uuid::Load(text.data()),
+                uuid::Load4(text.data() + 9) | uint64_t{uuid::Load4(text.data() + 14)} << 32,
+                uuid::Load4(text.data() + 19) | uint64_t{uuid::Load4(text.data() + 24)} << 32,
+                uuid::Load(text.data() + 28)
+            };
+
+            Uuid uuid;
+            for (size_t i = 0; i < 4; i++) {
+                uint32_t word;
+                if (!uuid::Decode(words[i], word)) {
+                    return std::nullopt;
+                }
+                std::memcpy(uuid.bytes.data() + 4 * i, &word, 4);
+            }
+            return uuid;
+        }
+
+        // For ids that were validated before reaching the caller.
+        static Uuid Require(const std::string_view text) {
+            if (auto uuid = Parse(text)) {
+                return *uuid;
+            }
+            throw std::invalid_argument("malformed id: " + std::string{text});
+        }
+
+        // Writes the 36 character lowercase form.
+        void Format(char* out) const {
+            char digits[32];
+            for (size_t i = 0; i < 4; i++) {
+                uint32_t word;
+                std::memcpy(&word, bytes.data() + 4 * i, 4);
+                const uint64_t encoded = uuid::Encode(word);
+                std::memcpy(digits + 8 * i, &encoded, 8);
+            }
+            std::memcpy(out, digits, 8);
+            out[8] = '-';
+            std::memcpy(out + 9, digits + 8, 4);
+            out[13] = '-';
+            std::memcpy(out + 14, digits + 12, 4);
+            out[18] = '-';
+            std::memcpy(out + 19, digits + 16, 4);
+            out[23] = '-';
+            std::memcpy(out + 24, digits + 20, 12);
+        }
+
+        [[nodiscard]] std::string ToString() const {
+            std::string text(TextSize, '\0');
+            Format(text.data());
+            return text;
+        }
+
+        // network order bytes, the binary wire format of the Postgres uuid type
+        [[nodiscard]] std::basic_string_view<std::byte> Binary() const {
+            return {bytes.data(), bytes.size()};
+        }
+
+        auto operator<=>(const Uuid&) const = default;
+    };
+}
+
+#endif //DOMAIN_UUID_HPP
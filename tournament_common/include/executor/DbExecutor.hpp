@@ -0,0 +1,96 @@
+#ifndef COMMON_DB_EXECUTOR_HPP
+#define COMMON_DB_EXECUTOR_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads that run the blocking database work of requests, one per pooled connection
+// rather than one per HTTP worker. The HTTP threads only parse, queue and write, so a slow query
+// holds a database thread and a connection but never an I/O thread. A pqxx query keeps its
+// connection busy until the result arrives, so with a thread per connection the queries in flight
+// are bounded by the pool and not by the threads.
+//
+// The queue is bounded: Submit() refuses work once maxQueued tasks are waiting, callers turn that
+// into a 503 instead of letting latency grow without limit. Tasks still queued at Shutdown() or
+// destruction run before the threads exit, every accepted task runs exactly once.
+class DbExecutor {
+    std::mutex mutex;
+    std::condition_variable available;
+    std::deque<std::function<void()>> tasks;
+    size_t maxQueued;
+    bool stopping = false;
+    // declared last so the threads are joined before the queue is destroyed
+    std::vector<std::jthread> threads;
+
+    void Run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex);
+                available.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+public:
+    DbExecutor(const size_t threadCount, const size_t maxQueued) : maxQueued(maxQueued) {
+        threads.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; i++) {
+            threads.emplace_back([this] { Run(); });
+        }
+    }
+
+    ~DbExecutor() {
+        Shutdown();
+    }
+
+    DbExecutor(const DbExecutor&) = delete;
+    DbExecutor& operator=(const DbExecutor&) = delete;
+
+    // Queues task for one of the threads. False, and task is not run, when the queue is full or
+    // the executor is shutting down. Tasks must not throw.
+    bool Submit(std::function<void()> task) {
+        {
+            std::lock_guard lock(mutex);
+            if (stopping || tasks.size() >= maxQueued) {
+                return false;
+            }
+            tasks.push_back(std::move(task));
+        }
+        available.notify_one();
+        return true;
+    }
+
+    // Refuses new work, runs what is queued and joins the threads. Tasks reference the request and
+    // response of their connection, so the server calls this once it stopped accepting and before
+    // its connections are destroyed. Must not be called from a task.
+    void Shutdown() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (auto& thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+    [[nodiscard]] size_t ThreadCount() const {
+        return threads.size();
+    }
+};
+
+#endif //COMMON_DB_EXECUTOR_HPP
@@ -0,0 +1,273 @@
+#ifndef COMMON_METRICS_HPP
+#define COMMON_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Counters and latency histograms rendered in the Prometheus text format. Every series owns a
+// range of cells, and every thread has its own shard holding all the cells. Recording is a relaxed
+// load and store on the calling thread's shard, no lock and no shared cache line. A scrape sums the
+// shards under the registry mutex.
+//
+// Series are registered up front (when a route is bound, when a provider is built). Registering the
+// same name and labels again returns the same series.
+namespace metrics {
+    using Clock = std::chrono::steady_clock;
+
+    // Upper bounds of the latency buckets, from half a millisecond to ten seconds.
+    inline constexpr std::array<Clock::duration, 14> LatencyBuckets = {
+        std::chrono::microseconds(500), std::chrono::milliseconds(1), std::chrono::microseconds(2500),
+        std::chrono::milliseconds(5), std::chrono::milliseconds(10), std::chrono::milliseconds(25),
+        std::chrono::milliseconds(50), std::chrono::milliseconds(100), std::chrono::milliseconds(250),
+        std::chrono::milliseconds(500), std::chrono::seconds(1), std::chrono::milliseconds(2500),
+        std::chrono::seconds(5), std::chrono::seconds(10)
+    };
+
+    // a cell per bucket, one for +Inf and one for the sum in nanoseconds
+    inline constexpr uint32_t HistogramCells = LatencyBuckets.size() + 2;
+
+    inline constexpr uint32_t MaxCells = 4096;
+
+    // Cells of one thread. Only the owning thread writes them.
+    struct Shard {
+        std::unique_ptr<std::atomic<uint64_t>[]> cells = std::make_unique<std::atomic<uint64_t>[]>(MaxCells);
+
+        void Add(const uint32_t cell, const uint64_t value) const noexcept {
+            auto& target = cells[cell];
+            target.store(target.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    };
+
+    Shard& LocalShard();
+
+    // Cell 0 is never scraped, default constructed handles write there and are harmless.
+    class Counter {
+        uint32_t cell = 0;
+
+    public:
+        Counter() = default;
+        explicit Counter(const uint32_t cell) : cell(cell) {}
+
+        void Add(const uint64_t value = 1) const noexcept {
+            LocalShard().Add(cell, value);
+        }
+
+        [[nodiscard]] uint32_t Cell() const { return cell; }
+    };
+
+    class Histogram {
+        uint32_t cell = 0;
+
+    public:
+        Histogram() = default;
+        explicit Histogram(const uint32_t cell) : cell(cell) {}
+
+        void Observe(const Clock::duration elapsed) const noexcept {
+            if (cell == 0) {
+                return;
+            }
+            uint32_t bucket = 0;
+            while (bucket < LatencyBuckets.size() && elapsed > LatencyBuckets[bucket]) {
+                ++bucket;
+            }
+            const Shard& shard = LocalShard();
+            shard.Add(cell + bucket, 1);
+            shard.Add(cell + HistogramCells - 1, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    };
+
+    // Observes the time between construction and destruction.
+    class Timer {
+        Histogram histogram;
+        Clock::time_point start = Clock::now();
+
+    public:
+        explicit Timer(const Histogram histogram) : histogram(histogram) {}
+        ~Timer() { histogram.Observe(Clock::now() - start); }
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+    };
+
+    // name="value" with the value escaped as the text format requires
+    inline std::string Label(const std::string_view name, const std::string_view value) {
+        std::string label{name};
+        label += "=\"";
+        for (const char c : value) {
+            if (c == '\\' || c == '"') {
+                label.push_back('\\');
+                label.push_back(c);
+            } else if (c == '\n') {
+                label += "\\n";
+            } else {
+                label.push_back(c);
+            }
+        }
+        label.push_back('"');
+        return label;
+    }
+
+    class Registry {
+        enum class Kind { Counter, Histogram };
+
+        struct Series {
+            std::string labels;
+            uint32_t cell;
+        };
+
+        struct Family {
+            std::string name;
+            std::string help;
+            Kind kind;
+            std::vector<Series> series;
+        };
+
+        mutable std::mutex mutex;
+        std::vector<Family> families;
+        uint32_t nextCell = 1;
+        std::vector<std::unique_ptr<Shard>> shards;
+        // shards of threads that exited, their counts stay and the next new thread continues them
+        std::vector<Shard*> freeShards;
+
+        uint32_t Register(const std::string_view name, const std::string_view help, const std::string_view labels,
+                          const Kind kind, const uint32_t cells) {
+            std::lock_guard lock(mutex);
+            Family* family = nullptr;
+            for (auto& candidate : families) {
+                if (candidate.name == name) {
+                    family = &candidate;
+                    break;
+                }
+            }
+            if (family == nullptr) {
+                family = &families.emplace_back(Family{std::string{name}, std::string{help}, kind, {}});
+            } else if (family->kind != kind) {
+                throw std::logic_error(std::format("metric {} registered with two types", name));
+            }
+            for (const auto& series : family->series) {
+                if (series.labels == labels) {
+                    return series.cell;
+                }
+            }
+            if (nextCell + cells > MaxCells) {
+                throw std::length_error(std::format("no metric cells left for {}", name));
+            }
+            const uint32_t cell = nextCell;
+            nextCell += cells;
+            family->series.push_back({std::string{labels}, cell});
+            return cell;
+        }
+
+        // Sum of every shard, indexed by cell. Called with the mutex held.
+        [[nodiscard]] std::vector<uint64_t> Merge() const {
+            std::vector<uint64_t> totals(nextCell, 0);
+            for (const auto& shard : shards) {
+                for (uint32_t cell = 1; cell < nextCell; cell++) {
+                    totals[cell] += shard->cells[cell].load(std::memory_order_relaxed);
+                }
+            }
+            return totals;
+        }
+
+        static void Sample(std::string& out, const std::string_view name, const std::string_view labels, const std::string_view value) {
+            out += name;
+            if (!labels.empty()) {
+                out.push_back('{');
+                out += labels;
+                out.push_back('}');
+            }
+            out.push_back(' ');
+            out += value;
+            out.push_back('\n');
+        }
+
+    public:
+        static Registry& Instance() {
+            static Registry registry;
+            return registry;
+        }
+
+        // labels are name="value" pairs joined by commas, see Label()
+        Counter AddCounter(const std::string_view name, const std::string_view help, const std::string_view labels = {}) {
+            return Counter{Register(name, help, labels, Kind::Counter, 1)};
+        }
+
+        Histogram AddHistogram(const std::string_view name, const std::string_view help, const std::string_view labels = {}) {
+            return Histogram{Register(name, help, labels, Kind::Histogram, HistogramCells)};
+        }
+
+        [[nodiscard]] uint64_t Total(const Counter counter) const {
+            std::lock_guard lock(mutex);
+            uint64_t total = 0;
+            for (const auto& shard : shards) {
+                total += shard->cells[counter.Cell()].load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        Shard* AcquireShard() {
+            std::lock_guard lock(mutex);
+            if (!freeShards.empty()) {
+                Shard* shard = freeShards.back();
+                freeShards.pop_back();
+                return shard;
+            }
+            return shards.emplace_back(std::make_unique<Shard>()).get();
+        }
+
+        void ReleaseShard(Shard* shard) {
+            std::lock_guard lock(mutex);
+            freeShards.push_back(shard);
+        }
+
+        // Appends every family in the Prometheus text exposition format.
+        void Write(std::string& out) const {
+            std::lock_guard lock(mutex);
+            const std::vector<uint64_t> totals = Merge();
+            for (const auto& family : families) {
+                out += std::format("# HELP {} {}\n# TYPE {} {}\n", family.name, family.help, family.name,
+                                   family.kind == Kind::Counter ? "counter" : "histogram");
+                for (const auto& series : family.series) {
+                    if (family.kind == Kind::Counter) {
+                        Sample(out, family.name, series.labels, std::to_string(totals[series.cell]));
+                        continue;
+                    }
+                    const std::string separator = series.labels.empty() ? "" : ",";
+                    const std::string bucketName = family.name + "_bucket";
+                    uint64_t count = 0;
+                    for (uint32_t bucket = 0; bucket <= LatencyBuckets.size(); bucket++) {
+                        count += totals[series.cell + bucket];
+                        const std::string bound = bucket < LatencyBuckets.size()
+                                                      ? std::format("{}", std::chrono::duration<double>(LatencyBuckets[bucket]).count())
+                                                      : "+Inf";
+                        Sample(out, bucketName, std::format("{}{}le=\"{}\"", series.labels, separator, bound), std::to_string(count));
+                    }
+                    const double seconds = static_cast<double>(totals[series.cell + HistogramCells - 1]) / 1e9;
+                    Sample(out, family.name + "_sum", series.labels, std::format("{:.6f}", seconds));
+                    Sample(out, family.name + "_count", series.labels, std::to_string(count));
+                }
+            }
+        }
+    };
+
+    inline Shard& LocalShard() {
+        // hands the shard back when the thread exits
+        struct Owner {
+            Shard* shard = Registry::Instance().AcquireShard();
+            ~Owner() { Registry::Instance().ReleaseShard(shard); }
+        };
+        thread_local Owner owner;
+        return *owner.shard;
+    }
+}
+
+#endif //COMMON_METRICS_HPP
@@ -5,8 +5,18 @@
 #ifndef TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
 #define TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
 
+#include <cstdint>
 #include <memory>
-#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// Thrown when no connection could be acquired within the pool's acquire timeout.
+// Controllers map it to 503 so load is shed instead of queued.
+class ConnectionPoolExhausted : public std::runtime_error {
+public:
+    explicit ConnectionPoolExhausted(const std::string& message) : std::runtime_error(message) {}
+};
 
 class IDbConnection {
 public:
@@ -14,28 +24,61 @@ public:
 };
 
 
+class IDbConnectionProvider;
+
+// RAII checkout of a pooled connection. It is just the connection pointer plus the slot it came
+// from, so a checkout does no heap allocation, and returning it is a single virtual call.
 class PooledConnection {
-    std::unique_ptr<IDbConnection, std::function<void(IDbConnection*)>> connection;
+    IDbConnection* connection = nullptr;
+    IDbConnectionProvider* owner = nullptr;
+    uint32_t slot = 0;
+
+    void Return() noexcept;
 public:
-    explicit PooledConnection(
-        IDbConnection* dbc,
-        std::function<void(IDbConnection*)> deleter) : connection(dbc, std::move(deleter)) {}
+    PooledConnection(IDbConnection* dbc, IDbConnectionProvider* owner, const uint32_t slot)
+        : connection(dbc), owner(owner), slot(slot) {}
+    ~PooledConnection() { Return(); }
 
-    IDbConnection* operator->() { return connection.get(); }
+    IDbConnection* operator->() { return connection; }
     IDbConnection& operator*() { return *connection; }
+
+    // The provider knows the concrete connection type it hands out, no RTTI needed.
+    template<typename Connection>
+    Connection* As() { return static_cast<Connection*>(connection); }
+
        // disable copy
     PooledConnection(const PooledConnection&) = delete;
     PooledConnection& operator=(const PooledConnection&) = delete;
 
     // allow move
-    PooledConnection(PooledConnection&&) noexcept = default;
-    PooledConnection& operator=(PooledConnection&&) noexcept = default;
+    PooledConnection(PooledConnection&& other) noexcept
+        : connection(std::exchange(other.connection, nullptr)), owner(other.owner), slot(other.slot) {}
+    PooledConnection& operator=(PooledConnection&& other) noexcept {
+        if (this != &other) {
+            Return();
+            connection = std::exchange(other.connection, nullptr);
+            owner = other.owner;
+            slot = other.slot;
+        }
+        return *this;
+    }
 };
 
 
 class IDbConnectionProvider {
+    friend class PooledConnection;
+protected:
+    // Gives back the connection checked out from the given slot.
+    virtual void Release(uint32_t slot) noexcept = 0;
 public:
     virtual ~IDbConnectionProvider() = default;
     virtual PooledConnection Connection() = 0;
 };
-#endif //TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
\ No newline at end of file
+
+inline void PooledConnection::Return() noexcept {
+    if (connection != nullptr) {
+        owner->Release(slot);
+        connection = nullptr;
+    }
+}
+#endif //TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
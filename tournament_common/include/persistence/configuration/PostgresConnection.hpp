@@ -4,17 +4,31 @@
 
 #ifndef TOURNAMENTS_POSTGRES_CONNECTION_HPP
 #define TOURNAMENTS_POSTGRES_CONNECTION_HPP
+#include <bitset>
 #include <memory>
 #include <pqxx/pqxx>
 #include "IDbConnectionProvider.hpp"
+#include "StatementCatalog.hpp"
 
 
 struct PostgresConnection final : IDbConnection{
     std::unique_ptr<pqxx::connection> connection;
+    // statements already prepared on this connection, indexed by statements::Statement::index
+    std::bitset<statements::Count> prepared;
+
     explicit PostgresConnection(std::unique_ptr<pqxx::connection> connection) : connection(std::move(connection)) {
     }
+
+    // Prepares the statement the first time it is used on this connection and returns its name.
+    const char* Prepare(const statements::Statement& statement) {
+        if (!prepared.test(statement.index)) {
+            connection->prepare(statement.name, statement.sql);
+            prepared.set(statement.index);
+        }
+        return statement.name;
+    }
 };
 
 
 
-#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
\ No newline at end of file
+#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
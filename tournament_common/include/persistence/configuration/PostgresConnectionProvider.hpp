@@ -4,79 +4,144 @@
 
 #ifndef TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
 #define TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
+#include <chrono>
 #include <condition_variable>
-#include <queue>
+#include <format>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include <pqxx/pqxx>
 
 #include "IDbConnectionProvider.hpp"
 #include "PostgresConnection.hpp"
+#include "SlotPool.hpp"
+#include "configuration/DatabaseConfiguration.hpp"
+#include "metrics/Metrics.hpp"
 
 class PostgresConnectionProvider : public IDbConnectionProvider{
-    std::string_view connectionString;
-    size_t poolSize = 1;
-    std::queue<std::unique_ptr<pqxx::connection>> connectionPool;
-    std::mutex connectionPoolMutex;
-    std::condition_variable connectionPoolCondition;
+    config::DatabaseConfiguration configuration;
+    SlotPool<PostgresConnection> pool;
 
-public:
-    PostgresConnectionProvider(std::string_view connectionString, size_t poolSize) : connectionString(connectionString), poolSize(poolSize) {
-        for (size_t i = 0; i < poolSize; i++) {
-            connectionPool.push(std::make_unique<pqxx::connection>(connectionString.data()));
-            connectionPool.back()->prepare("insert_tournament", "insert into TOURNAMENTS (document) values($1) RETURNING id");
-            connectionPool.back()->prepare("select_tournament_by_id", "select * from TOURNAMENTS where id = $1");
+    metrics::Histogram waitTime = metrics::Registry::Instance().AddHistogram(
+        "db_pool_wait_seconds", "Time Connection() waited for a pooled connection.");
+    metrics::Histogram checkoutTime = metrics::Registry::Instance().AddHistogram(
+        "db_connection_checkout_seconds", "Time a connection stayed checked out.");
+    metrics::Counter exhausted = metrics::Registry::Instance().AddCounter(
+        "db_pool_exhausted_total", "Connection() calls that gave up after acquireTimeout.");
+    // when each slot was checked out, only touched by the thread holding the slot
+    std::vector<metrics::Clock::time_point> checkedOutAt;
 
-            connectionPool.back()->prepare("insert_team", "insert into TEAMS (document) values($1) RETURNING id");
-            connectionPool.back()->prepare("select_team_by_id", "select * from TEAMS where id = $1");
+    // startup bookkeeping only, never touched by Connection()
+    size_t liveConnections = 0;
+    size_t pendingConnections = 0;
+    std::string lastConnectionError;
+    std::mutex startupMutex;
+    std::condition_variable startupCondition;
+    // declared last so the warm up threads are joined before anything else is destroyed
+    std::vector<std::jthread> warmup;
 
-            connectionPool.back()->prepare("insert_group", "insert into GROUPS (tournament_id, document) values($1, $2) RETURNING id");
-            connectionPool.back()->prepare("select_groups_by_tournament", "select * from GROUPS where tournament_id = $1");
-            connectionPool.back()->prepare("select_group_in_tournament", R"(
-                select * from groups
-                where  tournament_id = $1
-                and document @> jsonb_build_object('teams', jsonb_build_array(jsonb_build_object('id', $2::text)))
-            )");
+    static std::unique_ptr<PostgresConnection> OpenConnection(const std::string& connectionString) {
+        // statements are prepared lazily on first use, see PostgresConnection::Prepare
+        auto connection = std::make_unique<pqxx::connection>(connectionString);
+        return std::make_unique<PostgresConnection>(std::move(connection));
+    }
 
-            connectionPool.back()->prepare("select_group_by_tournamentid_groupid", "select * from GROUPS where tournament_id = $1 and id = $2");
-            // connectionPool.back()->prepare("update_group", "update GROUPS set name = $2, last_update_date = CURRENT_TIMESTAMP where id = $1  RETURNING id");
-            connectionPool.back()->prepare("update_group_add_team", R"(
-                update groups
-                    set document = jsonb_insert(
-                            document, '{teams,-1}', $2
-                                   ),
-                    last_update_date = CURRENT_TIMESTAMP
-                where id = $1
-            )");
+    // Cheap round trip used on connections that sat idle for a while, the server may have dropped them.
+    static bool IsAlive(PostgresConnection& connection) {
+        try {
+            pqxx::nontransaction tx(*connection.connection);
+            tx.exec("select 1");
+            return true;
+        } catch (const std::exception&) {
+            return false;
         }
     }
 
-    PooledConnection Connection() override {
-        std::unique_lock lock(connectionPoolMutex);
-
-        // wait until a connection is available
-        connectionPoolCondition.wait(lock, [this] { return !connectionPool.empty(); });
-
-        // take one out
-        auto conn = std::move(connectionPool.front());
-        connectionPool.pop();
-
-        // build PostgresConnection wrapper (adapts pqxx::connection -> IDbConnection)
-        auto dbc = new PostgresConnection(std::move(conn));
+    static SlotPool<PostgresConnection>::Options PoolOptions(const config::DatabaseConfiguration& configuration) {
+        return {
+            .minSize = configuration.minPoolSize,
+            .maxSize = configuration.maxPoolSize,
+            .acquireTimeout = configuration.acquireTimeout,
+            .idleTimeout = configuration.idleTimeout,
+            .validationInterval = configuration.validationInterval
+        };
+    }
 
-        // return a RAII PooledConnection
-        return PooledConnection(
-            dbc,
-            [this](IDbConnection* dbc) {
-                auto pc = dynamic_cast<PostgresConnection*>(dbc);
+protected:
+    void Release(const uint32_t slot) noexcept override {
+        checkoutTime.Observe(metrics::Clock::now() - checkedOutAt[slot]);
+        pool.Release(slot);
+    }
 
+public:
+    // Opens minPoolSize connections concurrently in the background, so startup does not grow
+    // with the pool size. Use WaitUntilReady() to block until readyPoolSize of them are live.
+    explicit PostgresConnectionProvider(const config::DatabaseConfiguration& configuration)
+        : configuration(configuration),
+          pool(PoolOptions(configuration), {
+              .create = [connectionString = configuration.connectionString] { return OpenConnection(connectionString); },
+              .isOpen = [](PostgresConnection& connection) { return connection.connection->is_open(); },
+              .ping = IsAlive
+          }),
+          checkedOutAt(configuration.maxPoolSize) {
+        pendingConnections = configuration.minPoolSize;
+        warmup.reserve(configuration.minPoolSize);
+        for (size_t i = 0; i < configuration.minPoolSize; i++) {
+            warmup.emplace_back([this] {
+                const uint32_t slot = pool.Reserve();
+                std::string error;
+                if (slot != SlotPool<PostgresConnection>::NoSlot) {
+                    try {
+                        pool.Install(slot, OpenConnection(this->configuration.connectionString));
+                    } catch (const std::exception& e) {
+                        pool.Abandon(slot);
+                        error = e.what();
+                    }
+                }
                 {
-                    std::lock_guard<std::mutex> lock(connectionPoolMutex);
-                    connectionPool.push(std::move(pc->connection));
+                    std::lock_guard lock(startupMutex);
+                    --pendingConnections;
+                    if (error.empty()) {
+                        ++liveConnections;
+                    } else {
+                        lastConnectionError = std::move(error);
+                    }
                 }
+                startupCondition.notify_all();
+            });
+        }
+    }
 
-                delete pc;
-                connectionPoolCondition.notify_one();
-            }
-        );
+    [[nodiscard]] bool IsReady() {
+        std::lock_guard lock(startupMutex);
+        return liveConnections >= configuration.readyPoolSize;
+    }
+
+    // Blocks until readyPoolSize connections are live. Throws if the warm up could not reach it
+    // within startupTimeout, either because connections failed or because they are too slow.
+    void WaitUntilReady() {
+        std::unique_lock lock(startupMutex);
+        startupCondition.wait_for(lock, configuration.startupTimeout, [this] {
+            return liveConnections >= configuration.readyPoolSize || pendingConnections == 0;
+        });
+        if (liveConnections < configuration.readyPoolSize) {
+            throw std::runtime_error(std::format("database pool not ready, {} of {} connections live: {}",
+                                                 liveConnections, configuration.readyPoolSize, lastConnectionError));
+        }
+    }
+
+    PooledConnection Connection() override {
+        const auto start = metrics::Clock::now();
+        try {
+            auto [connection, slot] = pool.Acquire();
+            checkedOutAt[slot] = metrics::Clock::now();
+            waitTime.Observe(checkedOutAt[slot] - start);
+            return PooledConnection(connection, this, slot);
+        } catch (const ConnectionPoolExhausted&) {
+            exhausted.Add();
+            throw;
+        }
     }
 };
-#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
\ No newline at end of file
+#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
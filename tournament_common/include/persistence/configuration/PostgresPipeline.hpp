@@ -0,0 +1,52 @@
+#ifndef COMMON_POSTGRES_PIPELINE_HPP
+#define COMMON_POSTGRES_PIPELINE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <pqxx/pqxx>
+
+#include "IDbConnectionProvider.hpp"
+#include "PostgresConnection.hpp"
+
+// Queues statements on one pooled connection and sends them to the server together, so N
+// statements cost one network round trip instead of N. Results are collected in queue order.
+//
+// pqxx::pipeline only takes plain SQL, so values are inlined with Quote(). The statements run on a
+// nontransaction and pqxx may send them in several batches, each statement commits on its own and
+// a failing one does not undo the ones before it. Use it for reads, or for writes where that is
+// acceptable; statements that must apply together belong in one pqxx::work.
+class PostgresPipeline {
+    PooledConnection pooled;
+    pqxx::nontransaction tx;
+    pqxx::pipeline pipeline;
+    std::vector<pqxx::pipeline::query_id> queued;
+
+public:
+    explicit PostgresPipeline(PooledConnection connection)
+        : pooled(std::move(connection)),
+          tx(*pooled.As<PostgresConnection>()->connection),
+          pipeline(tx) {}
+
+    template<typename Value>
+    std::string Quote(const Value& value) {
+        return tx.quote(value);
+    }
+
+    // Returns the position of the statement, used to read its result with Result().
+    size_t Queue(const std::string_view sql) {
+        queued.push_back(pipeline.insert(sql));
+        return queued.size() - 1;
+    }
+
+    // Waits for everything queued so far. Throws the first statement error, if any.
+    void Flush() {
+        pipeline.complete();
+    }
+
+    pqxx::result Result(const size_t position) {
+        return pipeline.retrieve(queued[position]);
+    }
+};
+
+#endif //COMMON_POSTGRES_PIPELINE_HPP
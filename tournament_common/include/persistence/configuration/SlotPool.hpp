@@ -0,0 +1,283 @@
+#ifndef COMMON_SLOT_POOL_HPP
+#define COMMON_SLOT_POOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "IDbConnectionProvider.hpp"
+
+// Fixed array of maxSize slots shared by any number of threads. Slots holding an open connection
+// sit on the idle stack, empty slots on the vacant stack. Both are lock free (Treiber stacks over
+// slot indices with a tag against ABA), so checkout and return never take a lock or allocate.
+// Only callers that find the pool at maxSize and fully checked out park on a condition variable.
+//
+// The idle stack is LIFO: hot connections are reused first and cold ones sink to the bottom,
+// where the idle sweep closes them once they exceed idleTimeout.
+template<typename T>
+class SlotPool {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        size_t minSize = 1;
+        size_t maxSize = 1;
+        std::chrono::milliseconds acquireTimeout{5000};
+        std::chrono::milliseconds idleTimeout{60000};
+        std::chrono::milliseconds validationInterval{30000};
+    };
+
+    struct Callbacks {
+        // opens a new connection, may throw
+        std::function<std::unique_ptr<T>()> create;
+        // cheap local check done when a connection is returned
+        std::function<bool(T&)> isOpen;
+        // round trip done before handing out a connection idle longer than validationInterval
+        std::function<bool(T&)> ping;
+    };
+
+    static constexpr uint32_t NoSlot = UINT32_MAX;
+
+private:
+    struct Slot {
+        std::unique_ptr<T> value;
+        std::atomic<uint32_t> next{NoSlot};
+        std::atomic<int64_t> releasedAt{0};
+    };
+
+    // {tag:32, index:32}, the tag changes on every successful push/pop
+    class IndexStack {
+        std::atomic<uint64_t> head{Pack(0, NoSlot)};
+
+        static constexpr uint64_t Pack(const uint32_t tag, const uint32_t index) {
+            return static_cast<uint64_t>(tag) << 32 | index;
+        }
+        static constexpr uint32_t Index(const uint64_t packed) { return static_cast<uint32_t>(packed); }
+        static constexpr uint32_t Tag(const uint64_t packed) { return static_cast<uint32_t>(packed >> 32); }
+
+    public:
+        void Push(Slot* slots, const uint32_t index) noexcept {
+            uint64_t current = head.load(std::memory_order_relaxed);
+            do {
+                slots[index].next.store(Index(current), std::memory_order_relaxed);
+            } while (!head.compare_exchange_weak(current, Pack(Tag(current) + 1, index),
+                                                 std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        uint32_t Pop(Slot* slots) noexcept {
+            uint64_t current = head.load(std::memory_order_acquire);
+            while (Index(current) != NoSlot) {
+                const uint32_t next = slots[Index(current)].next.load(std::memory_order_relaxed);
+                if (head.compare_exchange_weak(current, Pack(Tag(current) + 1, next),
+                                               std::memory_order_acquire, std::memory_order_acquire)) {
+                    return Index(current);
+                }
+            }
+            return NoSlot;
+        }
+
+        // detaches the whole stack in one step, returns the top index of the chain
+        uint32_t TakeAll() noexcept {
+            uint64_t current = head.load(std::memory_order_acquire);
+            while (!head.compare_exchange_weak(current, Pack(Tag(current) + 1, NoSlot),
+                                               std::memory_order_acquire, std::memory_order_acquire)) {
+            }
+            return Index(current);
+        }
+    };
+
+    Options options;
+    Callbacks callbacks;
+    std::unique_ptr<Slot[]> slots;
+    IndexStack idle;
+    IndexStack vacant;
+    std::atomic<size_t> openSlots{0};
+    std::atomic<size_t> waiters{0};
+    std::atomic<uint64_t> generation{0};
+    std::atomic<int64_t> lastSweep{0};
+    std::atomic_flag sweeping = ATOMIC_FLAG_INIT;
+    std::mutex parkMutex;
+    std::condition_variable parkCondition;
+
+    static int64_t Now() {
+        return Clock::now().time_since_epoch().count();
+    }
+
+    // Called after a slot was pushed. Pairs with the waiters increment in Acquire(): either the
+    // waiter sees the pushed slot or we see the waiter, so a wake up is never lost.
+    void WakeOne() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0) {
+            generation.fetch_add(1, std::memory_order_relaxed);
+            { std::lock_guard lock(parkMutex); }
+            parkCondition.notify_one();
+        }
+    }
+
+    void Vacate(const uint32_t index) noexcept {
+        slots[index].value.reset();
+        openSlots.fetch_sub(1, std::memory_order_relaxed);
+        vacant.Push(slots.get(), index);
+        WakeOne();
+    }
+
+    // Closes idle connections above minSize that were not used within idleTimeout.
+    // Runs at most once per half idleTimeout, from whichever thread returns a connection.
+    void SweepIdle(const int64_t now) {
+        const int64_t interval = std::chrono::duration_cast<Clock::duration>(options.idleTimeout).count() / 2;
+        int64_t last = lastSweep.load(std::memory_order_relaxed);
+        if (now - last < interval || !lastSweep.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+            return;
+        }
+        if (sweeping.test_and_set(std::memory_order_acquire)) {
+            return;
+        }
+
+        const int64_t idleTimeout = std::chrono::duration_cast<Clock::duration>(options.idleTimeout).count();
+        // the chain is ordered newest first, walk it and keep the survivors in the same order
+        uint32_t keep[64];
+        size_t kept = 0;
+        uint32_t index = idle.TakeAll();
+        while (index != NoSlot) {
+            const uint32_t next = slots[index].next.load(std::memory_order_relaxed);
+            const bool expired = now - slots[index].releasedAt.load(std::memory_order_relaxed) > idleTimeout;
+            if (expired && openSlots.load(std::memory_order_relaxed) > options.minSize) {
+                Vacate(index);
+            } else if (kept < std::size(keep)) {
+                keep[kept++] = index;
+            } else {
+                idle.Push(slots.get(), index);
+            }
+            index = next;
+        }
+        while (kept > 0) {
+            idle.Push(slots.get(), keep[--kept]);
+        }
+        sweeping.clear(std::memory_order_release);
+        WakeOne();
+    }
+
+    // Non blocking checkout attempt: idle slot first, then grow into a vacant one.
+    std::pair<T*, uint32_t> TryAcquire() {
+        const int64_t now = Now();
+        while (true) {
+            const uint32_t index = idle.Pop(slots.get());
+            if (index == NoSlot) {
+                break;
+            }
+            Slot& slot = slots[index];
+            const bool stale = now - slot.releasedAt.load(std::memory_order_relaxed)
+                               > std::chrono::duration_cast<Clock::duration>(options.validationInterval).count();
+            if (callbacks.isOpen(*slot.value) && (!stale || callbacks.ping(*slot.value))) {
+                return {slot.value.get(), index};
+            }
+            // dead connection, free the slot so it gets replaced
+            Vacate(index);
+        }
+
+        const uint32_t index = vacant.Pop(slots.get());
+        if (index == NoSlot) {
+            return {nullptr, NoSlot};
+        }
+        try {
+            slots[index].value = callbacks.create();
+        } catch (...) {
+            vacant.Push(slots.get(), index);
+            WakeOne();
+            throw;
+        }
+        openSlots.fetch_add(1, std::memory_order_relaxed);
+        return {slots[index].value.get(), index};
+    }
+
+public:
+    SlotPool(const Options& options, Callbacks callbacks)
+        : options(options), callbacks(std::move(callbacks)), slots(std::make_unique<Slot[]>(options.maxSize)) {
+        lastSweep.store(Now(), std::memory_order_relaxed);
+        for (size_t i = options.maxSize; i > 0; --i) {
+            vacant.Push(slots.get(), static_cast<uint32_t>(i - 1));
+        }
+    }
+
+    SlotPool(const SlotPool&) = delete;
+    SlotPool& operator=(const SlotPool&) = delete;
+
+    // Claims an empty slot to be filled with Install(), used to open connections ahead of demand.
+    uint32_t Reserve() noexcept {
+        return vacant.Pop(slots.get());
+    }
+
+    void Install(const uint32_t index, std::unique_ptr<T> value) {
+        slots[index].value = std::move(value);
+        slots[index].releasedAt.store(Now(), std::memory_order_relaxed);
+        openSlots.fetch_add(1, std::memory_order_relaxed);
+        idle.Push(slots.get(), index);
+        WakeOne();
+    }
+
+    void Abandon(const uint32_t index) noexcept {
+        vacant.Push(slots.get(), index);
+        WakeOne();
+    }
+
+    [[nodiscard]] size_t OpenSlots() const noexcept {
+        return openSlots.load(std::memory_order_relaxed);
+    }
+
+    // Returns the connection and its slot, or throws ConnectionPoolExhausted after acquireTimeout.
+    std::pair<T*, uint32_t> Acquire() {
+        if (auto acquired = TryAcquire(); acquired.first != nullptr) {
+            return acquired;
+        }
+
+        // slow path: the pool is at maxSize and everything is checked out
+        const auto deadline = Clock::now() + options.acquireTimeout;
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        struct Leave {
+            std::atomic<size_t>& waiters;
+            ~Leave() { waiters.fetch_sub(1, std::memory_order_relaxed); }
+        } leave{waiters};
+
+        while (true) {
+            const uint64_t seen = generation.load(std::memory_order_relaxed);
+            // opening a connection can take a while, never do it while holding parkMutex
+            if (auto acquired = TryAcquire(); acquired.first != nullptr) {
+                return acquired;
+            }
+            std::unique_lock lock(parkMutex);
+            const bool woken = parkCondition.wait_until(lock, deadline, [&] {
+                return generation.load(std::memory_order_relaxed) != seen;
+            });
+            if (!woken) {
+                lock.unlock();
+                if (auto acquired = TryAcquire(); acquired.first != nullptr) {
+                    return acquired;
+                }
+                throw ConnectionPoolExhausted(std::format("no database connection available after {}ms, {} connections in use",
+                                                          options.acquireTimeout.count(), options.maxSize));
+            }
+        }
+    }
+
+    void Release(const uint32_t index) noexcept {
+        Slot& slot = slots[index];
+        if (!callbacks.isOpen(*slot.value)) {
+            // broken while checked out, the next Acquire() opens a fresh one
+            Vacate(index);
+            return;
+        }
+        const int64_t now = Now();
+        slot.releasedAt.store(now, std::memory_order_relaxed);
+        idle.Push(slots.get(), index);
+        WakeOne();
+        SweepIdle(now);
+    }
+};
+
+#endif //COMMON_SLOT_POOL_HPP
@@ -0,0 +1,257 @@
+#ifndef COMMON_STATEMENT_CATALOG_HPP
+#define COMMON_STATEMENT_CATALOG_HPP
+
+#include <cstddef>
+
+// Every prepared statement used by the repositories. Connections prepare them lazily,
+// the first time a statement is executed on that connection (see PostgresConnection::Prepare).
+namespace statements {
+    struct Statement {
+        size_t index;
+        const char* name;
+        const char* sql;
+    };
+
+    // tournament changes queue their event in OUTBOX within the same statement, OutboxRelay publishes it
+    inline constexpr Statement InsertTournament{0, "insert_tournament", R"(
+        with inserted as (
+            insert into TOURNAMENTS (document) values($1) RETURNING id
+        ), event as (
+            insert into OUTBOX (queue, payload) select 'tournament.created', id::text from inserted
+        )
+        select id from inserted
+    )"};
+    inline constexpr Statement SelectTournamentById{1, "select_tournament_by_id", "select * from TOURNAMENTS where id = $1"};
+
+    inline constexpr Statement InsertTeam{2, "insert_team", "insert into TEAMS (document) values($1) RETURNING id"};
+    inline constexpr Statement SelectTeamById{3, "select_team_by_id", "select * from TEAMS where id = $1"};
+    // single probe of team_unique_name_idx, the expression must stay document->>'name' to use it
+    inline constexpr Statement TeamNameExists{14, "team_name_exists", "select 1 from TEAMS where document->>'name' = $1 limit 1"};
+    // takes the team out of every group it belongs to, document and GROUP_TEAMS, before deleting it
+    inline constexpr Statement DeleteTeam{12, "delete_team", R"(
+        with removed as (
+            delete from group_teams where team_id = $1 returning group_id
+        ), groups_updated as (
+            update groups
+                set document = jsonb_set(groups.document, '{teams}', coalesce(
+                        (select jsonb_agg(team) from jsonb_array_elements(groups.document->'teams') team
+                         where (team->>'id')::uuid <> $1), '[]'::jsonb)),
+                last_update_date = now()
+            where groups.id in (select group_id from removed)
+        )
+        delete from teams where id = $1 returning id
+    )"};
+
+    // group membership is mirrored in GROUP_TEAMS, every statement that changes document->'teams' updates it too
+    inline constexpr Statement InsertGroup{4, "insert_group", R"(
+        with inserted as (
+            insert into GROUPS (tournament_id, document) values($1, $2) RETURNING id, tournament_id, document
+        ), members as (
+            insert into GROUP_TEAMS (tournament_id, group_id, team_id)
+            select inserted.tournament_id, inserted.id, (team->>'id')::uuid
+            from inserted, jsonb_array_elements(coalesce(inserted.document->'teams', '[]'::jsonb)) team
+        )
+        select id from inserted
+    )"};
+    inline constexpr Statement SelectGroupsByTournament{5, "select_groups_by_tournament", "select * from GROUPS where tournament_id = $1"};
+    inline constexpr Statement SelectGroupInTournament{6, "select_group_in_tournament", R"(
+        select g.* from group_teams gt
+        join groups g on g.id = gt.group_id
+        where gt.tournament_id = $1 and gt.team_id = $2
+    )"};
+    inline constexpr Statement SelectGroupByTournamentIdGroupId{7, "select_group_by_tournamentid_groupid", "select * from GROUPS where tournament_id = $1 and id = $2"};
+    inline constexpr Statement UpdateGroupAddTeam{8, "update_group_add_team", R"(
+        with updated as (
+            update groups
+                set document = jsonb_insert(
+                        document, '{teams,-1}', $2
+                               ),
+                last_update_date = CURRENT_TIMESTAMP
+            where id = $1
+            returning id, tournament_id
+        )
+        insert into group_teams (tournament_id, group_id, team_id)
+        select tournament_id, id, ($2::jsonb->>'id')::uuid from updated
+    )"};
+
+    // Appends teams ($3) to a group in one statement: the tournament and group must exist, every id
+    // must exist, none may already be in a group of the tournament and the group must stay within the
+    // tournament's maxTeamsPerGroup. Repeated ids count once. The group row is locked so concurrent
+    // calls cannot both pass the capacity check, and the unique index on group_teams(tournament_id,
+    // team_id) stops a team from landing in two groups.
+    inline constexpr Statement AddTeamsToGroup{9, "add_teams_to_group", R"(
+        with requested as (
+            select id, min(position) as position
+            from unnest($3::uuid[]) with ordinality as requested(id, position)
+            group by id
+        ),
+        tournament as (
+            select id from tournaments where id = $1
+        ),
+        target as (
+            select g.id, coalesce(jsonb_array_length(g.document->'teams'), 0) as size,
+                   coalesce((t.document->'format'->>'maxTeamsPerGroup')::int, 16) as capacity
+            from groups g join tournaments t on t.id = g.tournament_id
+            where g.tournament_id = $1 and g.id = $2
+            for update of g
+        ),
+        found as (
+            select teams.id, requested.position,
+                   jsonb_build_object('id', teams.id::text, 'name', teams.document->>'name') as document
+            from teams join requested on requested.id = teams.id
+        ),
+        missing as (
+            select requested.id from requested
+            where not exists (select 1 from found where found.id = requested.id)
+            order by requested.position limit 1
+        ),
+        assigned as (
+            select found.id from found
+            join group_teams on group_teams.tournament_id = $1 and group_teams.team_id = found.id
+            order by found.position limit 1
+        ),
+        updated as (
+            update groups
+                set document = jsonb_set(groups.document, '{teams}',
+                        coalesce(groups.document->'teams', '[]'::jsonb)
+                        || coalesce((select jsonb_agg(document order by position) from found), '[]'::jsonb)),
+                last_update_date = CURRENT_TIMESTAMP
+            from target
+            where groups.id = target.id
+            and not exists (select 1 from missing)
+            and not exists (select 1 from assigned)
+            and target.size + (select count(*) from requested) <= target.capacity
+            returning groups.id, groups.tournament_id
+        ),
+        members as (
+            insert into group_teams (tournament_id, group_id, team_id)
+            select updated.tournament_id, updated.id, found.id from updated, found
+        )
+        select case
+                   when not exists (select 1 from tournament) then 'tournament_not_found'
+                   when not exists (select 1 from target) then 'group_not_found'
+                   when exists (select 1 from target where size + (select count(*) from requested) > capacity) then 'group_full'
+                   when exists (select 1 from missing) then 'team_not_found'
+                   when exists (select 1 from assigned) then 'team_already_assigned'
+                   else 'added'
+               end as status,
+               coalesce((select id::text from missing), (select id::text from assigned)) as team_id
+    )"};
+
+    // keyset pages, see persistence/repository/Page.hpp. $1/$2 are the created_at/id of the previous
+    // page's last row, $3 the page size plus one so the caller knows whether another page follows.
+    inline constexpr Statement SelectTeamsPage{10, "select_teams_page", R"(
+        select id, document, created_at::text as created_at from teams
+        where (created_at, id) > ($1::timestamp, $2::uuid)
+        order by created_at, id limit $3
+    )"};
+    inline constexpr Statement SelectTournamentsPage{11, "select_tournaments_page", R"(
+        select id, document, created_at::text as created_at from tournaments
+        where (created_at, id) > ($1::timestamp, $2::uuid)
+        order by created_at, id limit $3
+    )"};
+    inline constexpr Statement SelectGroupsByTournamentPage{13, "select_groups_by_tournament_page", R"(
+        select id, document, created_at::text as created_at from groups
+        where tournament_id = $4 and (created_at, id) > ($1::timestamp, $2::uuid)
+        order by created_at, id limit $3
+    )"};
+
+    // Row versions for conditional requests: last_update_date in microseconds, read without touching
+    // the document. A collection version pairs the row count with the newest change, so inserts,
+    // updates and deletes all move it.
+    inline constexpr Statement SelectTournamentsVersion{15, "select_tournaments_version", R"(
+        select count(*) || '.' || coalesce((extract(epoch from max(last_update_date)) * 1000000)::bigint, 0) as version
+        from tournaments
+    )"};
+    // $3 lists the versions the client accepts (If-Match). found tells a missing row from a stale one,
+    // version is the new version or null when nothing was written.
+    inline constexpr Statement UpdateTournamentIfVersion{16, "update_tournament_if_version", R"(
+        with target as (
+            select id, (extract(epoch from last_update_date) * 1000000)::bigint as version
+            from tournaments where id = $2
+            for update
+        ), updated as (
+            update tournaments set document = $1, last_update_date = now()
+            from target
+            where tournaments.id = target.id and target.version = any($3::bigint[])
+            returning tournaments.id, (extract(epoch from tournaments.last_update_date) * 1000000)::bigint as version
+        ), event as (
+            insert into OUTBOX (queue, payload) select 'tournament.updated', id::text from updated
+        )
+        select exists (select 1 from target) as found, (select version from updated) as version
+    )"};
+    inline constexpr Statement SelectTournamentVersion{25, "select_tournament_version", R"(
+        select (extract(epoch from last_update_date) * 1000000)::bigint as version from tournaments where id = $1
+    )"};
+    inline constexpr Statement SelectGroupVersion{17, "select_group_version", R"(
+        select (extract(epoch from last_update_date) * 1000000)::bigint as version from groups
+        where tournament_id = $1 and id = $2
+    )"};
+    // answered from group_teams_tournament_team_idx
+    inline constexpr Statement CountTeamsInTournament{24, "count_teams_in_tournament",
+        "select count(*) as teams from GROUP_TEAMS where tournament_id = $1"};
+    // GroupRepository::Update with the same version check as UpdateTournamentIfVersion, $4 the accepted versions
+    inline constexpr Statement UpdateGroupIfVersion{18, "update_group_if_version", R"(
+        with target as (
+            select id, (extract(epoch from last_update_date) * 1000000)::bigint as version
+            from groups where id = $1 and tournament_id = $3
+            for update
+        ), updated as (
+            update groups set document = $2::jsonb, last_update_date = now()
+            from target
+            where groups.id = target.id and target.version = any($4::bigint[])
+            returning groups.id, groups.tournament_id, groups.document,
+                      (extract(epoch from groups.last_update_date) * 1000000)::bigint as version
+        ), members as (
+            select updated.tournament_id, updated.id as group_id, (team->>'id')::uuid as team_id
+            from updated, jsonb_array_elements(coalesce(updated.document->'teams', '[]'::jsonb)) team
+        ), removed as (
+            delete from group_teams
+            where group_id in (select id from updated)
+            and not exists (select 1 from members where members.team_id = group_teams.team_id)
+        ), added as (
+            insert into group_teams (tournament_id, group_id, team_id)
+            select * from members
+            where not exists (select 1 from group_teams gt where gt.group_id = members.group_id and gt.team_id = members.team_id)
+        )
+        select exists (select 1 from target) as found, (select version from updated) as version
+    )"};
+
+    // returns the new version too, so an unconditional PUT can hand out the tag for the next If-Match
+    inline constexpr Statement UpdateTournament{19, "update_tournament", R"(
+        with updated as (
+            update tournaments set document = $1, last_update_date = now() where id = $2
+            returning id, (extract(epoch from last_update_date) * 1000000)::bigint as version
+        ), event as (
+            insert into OUTBOX (queue, payload) select 'tournament.updated', id::text from updated
+        )
+        select id, version from updated
+    )"};
+    inline constexpr Statement DeleteTournament{20, "delete_tournament", R"(
+        with deleted as (
+            delete from tournaments where id = $1 returning id
+        ), event as (
+            insert into OUTBOX (queue, payload) select 'tournament.deleted', id::text from deleted
+        )
+        select id from deleted
+    )"};
+
+    // Claims up to $1 events nobody holds a live claim on for $2 milliseconds. Rows another relay is
+    // claiming right now are skipped. Committed on its own, the events are sent after it.
+    inline constexpr Statement ClaimOutboxEvents{21, "claim_outbox_events", R"(
+        update OUTBOX set claimed_until = now() + $2 * interval '1 millisecond'
+        where id in (
+            select id from OUTBOX where claimed_until is null or claimed_until < now()
+            order by id limit $1 for update skip locked
+        )
+        returning id, queue, payload
+    )"};
+    inline constexpr Statement DeleteOutboxEvents{22, "delete_outbox_events",
+        "delete from OUTBOX where id = any($1::bigint[])"};
+    inline constexpr Statement ReleaseOutboxEvents{23, "release_outbox_events",
+        "update OUTBOX set claimed_until = null where id = any($1::bigint[])"};
+
+    inline constexpr size_t Count = 26;
+}
+
+#endif //COMMON_STATEMENT_CATALOG_HPP
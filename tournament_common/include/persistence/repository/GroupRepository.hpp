@@ -7,6 +7,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "IGroupRepository.hpp"
 #include "persistence/configuration/IDbConnectionProvider.hpp"
@@ -23,9 +24,15 @@ public:
     void Delete(std::string id) override;
     std::vector<std::shared_ptr<domain::Group>> ReadAll() override;
     std::vector<std::shared_ptr<domain::Group>> FindByTournamentId(const std::string_view& tournamentId) override;
+    Page<domain::Group> ReadPage(const PageRequest& page) override;
+    Page<domain::Group> FindByTournamentId(const std::string_view& tournamentId, const PageRequest& page) override;
     std::shared_ptr<domain::Group> FindByTournamentIdAndGroupId(const std::string_view& tournamentId, const std::string_view& groupId) override;
     std::shared_ptr<domain::Group> FindByTournamentIdAndTeamId(const std::string_view& tournamentId, const std::string_view& teamId) override;
     void UpdateGroupAddTeam(const std::string_view& groupId, const std::shared_ptr<domain::Team> & team) override;
+    AddTeamsResult AddTeams(const std::string_view& tournamentId, const std::string_view& groupId, const std::vector<std::string>& teamIds) override;
+    size_t CountTeams(const std::string_view& tournamentId) override;
+    std::string GroupVersion(const std::string_view& tournamentId, const std::string_view& groupId) override;
+    std::optional<std::string> UpdateIfVersion(const domain::Group& entity, const std::vector<std::string>& versions) override;
 };
 
 #endif //TOURNAMENTS_GROUPREPOSITORY_HPP
\ No newline at end of file
@@ -5,15 +5,42 @@
 #ifndef COMMON_IGROUPREPOSITORY_HPP
 #define COMMON_IGROUPREPOSITORY_HPP
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "domain/Group.hpp"
 #include "IRepository.hpp"
 
+enum class AddTeamsStatus {
+    Added,
+    TournamentNotFound,
+    GroupNotFound,
+    TeamNotFound,
+    TeamAlreadyAssigned,
+    GroupFull
+};
+
+struct AddTeamsResult {
+    AddTeamsStatus status;
+    // the offending team for TeamNotFound and TeamAlreadyAssigned
+    std::string teamId;
+};
 
 class IGroupRepository : public IRepository<domain::Group, std::string> {
 public:
     virtual std::vector<std::shared_ptr<domain::Group>> FindByTournamentId(const std::string_view& tournamentId) = 0;
+    virtual Page<domain::Group> FindByTournamentId(const std::string_view& tournamentId, const PageRequest& page) = 0;
     virtual std::shared_ptr<domain::Group> FindByTournamentIdAndGroupId(const std::string_view& tournamentId, const std::string_view& groupId) = 0;
     virtual std::shared_ptr<domain::Group> FindByTournamentIdAndTeamId(const std::string_view& tournamentId, const std::string_view& teamId) = 0;
     virtual void UpdateGroupAddTeam(const std::string_view& groupId, const std::shared_ptr<domain::Team> & team) = 0;
+    // Validates and appends all the teams in one atomic statement, see AddTeamsResult for the outcomes.
+    virtual AddTeamsResult AddTeams(const std::string_view& tournamentId, const std::string_view& groupId, const std::vector<std::string>& teamIds) = 0;
+    // Teams assigned to any group of the tournament.
+    virtual size_t CountTeams(const std::string_view& tournamentId) = 0;
+    // Version() of a group within its tournament, empty when the group is not in it.
+    virtual std::string GroupVersion(const std::string_view&, const std::string_view&) {
+        return {};
+    }
 };
 #endif //COMMON_IGROUPREPOSITORY_HPP
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef COMMON_IOUTBOX_REPOSITORY_HPP
+#define COMMON_IOUTBOX_REPOSITORY_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct OutboxEvent {
+    int64_t id = 0;
+    std::string queue;
+    std::string payload;
+};
+
+// The OUTBOX rows OutboxRelay publishes. A claim is a lease, not a lock: it is committed right away,
+// so no connection or row lock is held while the events are sent, and it lapses on its own if the
+// relay never deletes or releases the rows.
+class IOutboxRepository {
+public:
+    virtual ~IOutboxRepository() = default;
+    // Up to limit unclaimed (or expired) events in the order they were written, claimed for lease.
+    virtual std::vector<OutboxEvent> Claim(size_t limit, std::chrono::milliseconds lease) = 0;
+    // The events were published.
+    virtual void Delete(const std::vector<int64_t>& ids) = 0;
+    // Publishing failed, the next claim may take the events again.
+    virtual void Release(const std::vector<int64_t>& ids) = 0;
+};
+
+#endif //COMMON_IOUTBOX_REPOSITORY_HPP
@@ -4,9 +4,15 @@
 
 #ifndef RESTAPI_IREPOSITORY_HPP
 #define RESTAPI_IREPOSITORY_HPP
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <memory>
 
+#include "Page.hpp"
+
 template<typename Type, typename Id>
 class IRepository {
 public:
@@ -22,5 +28,41 @@ public:
 
 
     virtual std::vector<std::shared_ptr<Type>> ReadAll() = 0;
+    // Throws std::invalid_argument when page.after is not a cursor returned by a previous page.
+    virtual Page<Type> ReadPage(const PageRequest& page) = 0;
+
+    // Hands every entity to consumer one at a time. Repositories that can stream rows from the
+    // database override it so the rows are never collected in a result or a vector; by default it
+    // falls back to ReadAll().
+    virtual void StreamAll(const std::function<void(const Type&)>& consumer) {
+        for (const auto& entity : ReadAll()) {
+            consumer(*entity);
+        }
+    }
+
+    // Version of a row for conditional requests, it changes whenever the row does. Read without the
+    // document. Empty when there is no such row or the repository does not keep versions.
+    virtual std::string Version(Id) {
+        return {};
+    }
+
+    // Update() that also returns the row's new version, read back by the same statement. Empty when
+    // the repository does not keep versions.
+    virtual std::string UpdateReturningVersion(const Type& entity) {
+        Update(entity);
+        return {};
+    }
+
+    // Same for the whole table: any insert, update or delete changes it.
+    virtual std::string CollectionVersion() {
+        return {};
+    }
+
+    // Update() applied only while the row is still at one of versions, checked and written in one
+    // statement. Returns the new version, or nullopt when the row has moved on. Throws like Update()
+    // when there is no such row.
+    virtual std::optional<std::string> UpdateIfVersion(const Type&, const std::vector<std::string>&) {
+        throw std::logic_error("conditional updates are not supported by this repository");
+    }
 };
 #endif //RESTAPI_IREPOSITORY_HPP
\ No newline at end of file
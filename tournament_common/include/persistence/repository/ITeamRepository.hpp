@@ -0,0 +1,25 @@
+#ifndef COMMON_ITEAMREPOSITORY_HPP
+#define COMMON_ITEAMREPOSITORY_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "domain/Team.hpp"
+#include "IRepository.hpp"
+
+// Outcome of one row of CreateMany, results are in the same order as the input.
+struct TeamImportResult {
+    // generated id, empty when the row was not inserted
+    std::string id;
+    // the name already exists, or appears earlier in the same batch
+    bool duplicate = false;
+};
+
+class ITeamRepository : public IRepository<domain::Team, std::string_view> {
+public:
+    virtual std::vector<TeamImportResult> CreateMany(const std::vector<domain::Team>& teams) = 0;
+    // Index lookup on the team name, does not read any other team.
+    virtual bool ExistsByName(std::string_view name) = 0;
+};
+#endif //COMMON_ITEAMREPOSITORY_HPP
@@ -0,0 +1,20 @@
+#ifndef COMMON_OUTBOX_REPOSITORY_HPP
+#define COMMON_OUTBOX_REPOSITORY_HPP
+
+#include <memory>
+#include <vector>
+
+#include "IOutboxRepository.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
+#include "persistence/configuration/PostgresConnection.hpp"
+
+class OutboxRepository : public IOutboxRepository {
+    std::shared_ptr<IDbConnectionProvider> connectionProvider;
+public:
+    explicit OutboxRepository(const std::shared_ptr<IDbConnectionProvider>& connectionProvider);
+    std::vector<OutboxEvent> Claim(size_t limit, std::chrono::milliseconds lease) override;
+    void Delete(const std::vector<int64_t>& ids) override;
+    void Release(const std::vector<int64_t>& ids) override;
+};
+
+#endif //COMMON_OUTBOX_REPOSITORY_HPP
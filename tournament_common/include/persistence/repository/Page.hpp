@@ -0,0 +1,133 @@
+#ifndef COMMON_PAGE_HPP
+#define COMMON_PAGE_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "domain/Uuid.hpp"
+
+// Keyset pagination over (created_at, id). A page costs one index range scan of `limit` rows
+// no matter how deep into the table it is.
+struct PageRequest {
+    size_t limit = 100;
+    // cursor returned with the previous page, empty for the first one
+    std::string after;
+};
+
+template<typename Type>
+struct Page {
+    std::vector<std::shared_ptr<Type>> items;
+    // empty on the last page
+    std::string nextCursor;
+};
+
+// The cursor is the last row's created_at and id, base64url encoded so clients treat it as opaque.
+namespace cursor {
+    struct Position {
+        std::string createdAt;
+        std::string id;
+    };
+
+    // starts before every row, used for the first page
+    inline const Position First{"-infinity", "00000000-0000-0000-0000-000000000000"};
+
+    inline constexpr std::string_view Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+    inline std::string Encode(const std::string_view createdAt, const std::string_view id) {
+        std::string plain;
+        plain.reserve(createdAt.size() + id.size() + 1);
+        plain.append(createdAt).append("|").append(id);
+
+        std::string encoded;
+        encoded.reserve((plain.size() + 2) / 3 * 4);
+        uint32_t buffer = 0;
+        int bits = 0;
+        for (const unsigned char c : plain) {
+            buffer = buffer << 8 | c;
+            bits += 8;
+            while (bits >= 6) {
+                bits -= 6;
+                encoded.push_back(Alphabet[buffer >> bits & 0x3F]);
+            }
+        }
+        if (bits > 0) {
+            encoded.push_back(Alphabet[buffer << (6 - bits) & 0x3F]);
+        }
+        return encoded;
+    }
+
+    // created_at::text of a timestamp column: "YYYY-MM-DD HH:MM:SS" with up to 6 fractional digits
+    inline bool ValidTimestamp(const std::string_view text) {
+        constexpr std::string_view shape = "dddd-dd-dd dd:dd:dd";
+        if (text.size() < shape.size() || text.size() == shape.size() + 1 || text.size() > shape.size() + 7) {
+            return false;
+        }
+        const auto digit = [](const char c) { return c >= '0' && c <= '9'; };
+        for (size_t i = 0; i < shape.size(); i++) {
+            if (shape[i] == 'd' ? !digit(text[i]) : text[i] != shape[i]) {
+                return false;
+            }
+        }
+        if (text.size() > shape.size() && text[shape.size()] != '.') {
+            return false;
+        }
+        for (size_t i = shape.size() + 1; i < text.size(); i++) {
+            if (!digit(text[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Throws std::invalid_argument when the cursor was not produced by Encode(), so a tampered
+    // cursor is a bad request and never reaches the database.
+    inline Position Decode(const std::string_view encoded) {
+        static const std::array<int8_t, 256> values = [] {
+            std::array<int8_t, 256> table{};
+            table.fill(-1);
+            for (size_t i = 0; i < Alphabet.size(); i++) {
+                table[static_cast<unsigned char>(Alphabet[i])] = static_cast<int8_t>(i);
+            }
+            return table;
+        }();
+
+        std::string plain;
+        plain.reserve(encoded.size() * 3 / 4);
+        uint32_t buffer = 0;
+        int bits = 0;
+        for (const unsigned char c : encoded) {
+            const int8_t value = values[c];
+            if (value < 0) {
+                throw std::invalid_argument("invalid cursor");
+            }
+            buffer = buffer << 6 | static_cast<uint32_t>(value);
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                plain.push_back(static_cast<char>(buffer >> bits & 0xFF));
+            }
+        }
+
+        const auto separator = plain.find('|');
+        if (separator == std::string::npos || separator == 0 || separator + 1 == plain.size()) {
+            throw std::invalid_argument("invalid cursor");
+        }
+        Position position{plain.substr(0, separator), plain.substr(separator + 1)};
+        if (!ValidTimestamp(position.createdAt) || !domain::Uuid::Parse(position.id)) {
+            throw std::invalid_argument("invalid cursor");
+        }
+        return position;
+    }
+
+    inline Position From(const PageRequest& page) {
+        return page.after.empty() ? First : Decode(page.after);
+    }
+}
+
+#endif //COMMON_PAGE_HPP
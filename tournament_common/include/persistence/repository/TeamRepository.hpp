@@ -4,19 +4,24 @@
 
 #ifndef RESTAPI_TEAMREPOSITORY_HPP
 #define RESTAPI_TEAMREPOSITORY_HPP
+#include <algorithm>
+#include <format>
 #include <string>
 #include <memory>
-#include <nlohmann/json.hpp>
+#include <vector>
 
 
 #include "persistence/configuration/IDbConnectionProvider.hpp"
 #include "persistence/configuration/PostgresConnection.hpp"
-#include "IRepository.hpp"
+#include "persistence/configuration/PostgresPipeline.hpp"
+#include "ITeamRepository.hpp"
 #include "domain/Team.hpp"
-#include "domain/Utilities.hpp"
+#include "domain/JsonDecoder.hpp"
+#include "domain/JsonWriter.hpp"
+#include "domain/Uuid.hpp"
 
 
-class TeamRepository : public IRepository<domain::Team, std::string_view> {
+class TeamRepository : public ITeamRepository {
     std::shared_ptr<IDbConnectionProvider> connectionProvider;
 public:
 
@@ -26,7 +31,7 @@ public:
         std::vector<std::shared_ptr<domain::Team>> teams;
 
         auto pooled = connectionProvider->Connection();
-        auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+        auto connection = pooled.As<PostgresConnection>();
         
         pqxx::work tx(*(connection->connection));
         pqxx::result result{tx.exec("select id, document->>'name' as name from teams")};
@@ -39,43 +44,157 @@ public:
         return teams;
     }
 
+    void StreamAll(const std::function<void(const domain::Team&)>& consumer) override {
+        auto pooled = connectionProvider->Connection();
+        auto connection = pooled.As<PostgresConnection>();
+
+        pqxx::work tx(*(connection->connection));
+        domain::Team team;
+        for (auto [id, name] : tx.stream<std::string_view, std::string_view>("select id, document->>'name' as name from teams")) {
+            team.Id = id;
+            team.Name = name;
+            consumer(team);
+        }
+        tx.commit();
+    }
+
+    Page<domain::Team> ReadPage(const PageRequest& page) override {
+        const auto from = cursor::From(page);
+        auto pooled = connectionProvider->Connection();
+        auto connection = pooled.As<PostgresConnection>();
+
+        pqxx::work tx(*(connection->connection));
+        const auto after = domain::Uuid::Require(from.id);
+        const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::SelectTeamsPage)},
+                                            pqxx::params{from.createdAt, after.Binary(), page.limit + 1});
+        tx.commit();
+
+        Page<domain::Team> teams;
+        for (size_t i = 0; i < std::min<size_t>(result.size(), page.limit); i++) {
+            auto team = std::make_shared<domain::Team>(domain::FromDocument<domain::Team>(result[i]["document"].c_str()));
+            team->Id = result[i]["id"].c_str();
+            teams.items.push_back(team);
+        }
+        if (result.size() > page.limit) {
+            teams.nextCursor = cursor::Encode(result[page.limit - 1]["created_at"].c_str(), result[page.limit - 1]["id"].c_str());
+        }
+        return teams;
+    }
+
     std::shared_ptr<domain::Team> ReadById(std::string_view id) override {
+        const auto teamId = domain::Uuid::Require(id);
         auto pooled = connectionProvider->Connection();
-        auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+        auto connection = pooled.As<PostgresConnection>();
 
         pqxx::work tx(*(connection->connection));
-        pqxx::result result = tx.exec(pqxx::prepped{"select_team_by_id"}, id.data());
+        pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::SelectTeamById)}, pqxx::params{teamId.Binary()});
         tx.commit();
-        auto team = std::make_shared<domain::Team>( nlohmann::json::parse(result[0]["document"].c_str()));
+        auto team = std::make_shared<domain::Team>(domain::FromDocument<domain::Team>(result[0]["document"].c_str()));
         team->Id = result[0]["id"].c_str();
 
         return team;
     }
 
+    // Reads all the teams in a single round trip, ids that do not exist are left out.
+    virtual std::vector<std::shared_ptr<domain::Team>> ReadByIds(const std::vector<std::string>& ids) {
+        PostgresPipeline pipeline(connectionProvider->Connection());
+        for (const auto& id : ids) {
+            pipeline.Queue(std::format("select id, document from TEAMS where id = {}", pipeline.Quote(id)));
+        }
+        pipeline.Flush();
+
+        std::vector<std::shared_ptr<domain::Team>> teams;
+        for (size_t i = 0; i < ids.size(); i++) {
+            const pqxx::result result = pipeline.Result(i);
+            if (result.empty()) {
+                continue;
+            }
+            auto team = std::make_shared<domain::Team>(domain::FromDocument<domain::Team>(result[0]["document"].c_str()));
+            team->Id = result[0]["id"].c_str();
+            teams.push_back(team);
+        }
+        return teams;
+    }
+
+    bool ExistsByName(const std::string_view name) override {
+        auto pooled = connectionProvider->Connection();
+        auto connection = pooled.As<PostgresConnection>();
+
+        pqxx::nontransaction tx(*(connection->connection));
+        const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::TeamNameExists)},
+                                            pqxx::params{name});
+        return !result.empty();
+    }
+
     std::string_view Create(const domain::Team &entity) override {
         auto pooled = connectionProvider->Connection();
-        auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
-        nlohmann::json teamBody = entity;
+        auto connection = pooled.As<PostgresConnection>();
+        const std::string teamBody = domain::ToJson(entity);
 
         pqxx::work tx(*(connection->connection));
-        pqxx::result result = tx.exec(pqxx::prepped{"insert_team"}, teamBody.dump());
+        pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::InsertTeam)}, teamBody);
 
         tx.commit();
 
         return result[0]["id"].c_str();
     }
 
+    // Loads all the rows with COPY into a staging table and inserts them in one statement. Names that
+    // already exist, or repeat within the batch, are reported as duplicates instead of failing the batch.
+    std::vector<TeamImportResult> CreateMany(const std::vector<domain::Team>& teams) override {
+        auto pooled = connectionProvider->Connection();
+        auto connection = pooled.As<PostgresConnection>();
+
+        pqxx::work tx(*(connection->connection));
+        tx.exec("create temp table team_import (position int not null, document jsonb not null) on commit drop");
+        auto stream = pqxx::stream_to::table(tx, {"team_import"}, {"position", "document"});
+        for (size_t i = 0; i < teams.size(); i++) {
+            stream.write_values(static_cast<int>(i), domain::ToJson(domain::Team{"", teams[i].Name}));
+        }
+        stream.complete();
+
+        const pqxx::result result = tx.exec(R"(
+            with ranked as (
+                select position, document,
+                       row_number() over (partition by document->>'name' order by position) as occurrence
+                from team_import
+            ), inserted as (
+                insert into teams (document)
+                select document from ranked where occurrence = 1 order by position
+                on conflict ((document->>'name')) do nothing
+                returning id, document->>'name' as name
+            )
+            select ranked.position, inserted.id
+            from ranked
+            left join inserted on inserted.name = ranked.document->>'name' and ranked.occurrence = 1
+            order by ranked.position
+        )");
+        tx.commit();
+
+        std::vector<TeamImportResult> created(teams.size());
+        for (auto row : result) {
+            auto& team = created[row["position"].as<int>()];
+            if (row["id"].is_null()) {
+                team.duplicate = true;
+            } else {
+                team.id = row["id"].c_str();
+            }
+        }
+        return created;
+    }
+
     std::string_view Update(const domain::Team &entity) override {
         auto pooled = connectionProvider->Connection();
-        auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+        auto connection = pooled.As<PostgresConnection>();
 
-        nlohmann::json teamDoc = entity;
+        const std::string teamDoc = domain::ToJson(entity);
+        const auto teamId = domain::Uuid::Require(entity.Id);
 
         pqxx::work tx(*(connection->connection));
         pqxx::result r = tx.exec_params(
             "UPDATE teams SET document = $1 WHERE id = $2::uuid RETURNING id;",
-            teamDoc.dump(),
-            entity.Id
+            teamDoc,
+            teamId.Binary()
         );
 
         tx.commit();
@@ -88,18 +207,17 @@ public:
     }
 
     void Delete(std::string_view id) override {
+        const auto teamId = domain::Uuid::Require(id);
         auto pooled = connectionProvider->Connection();
-        auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+        auto connection = pooled.As<PostgresConnection>();
 
         pqxx::work tx(*(connection->connection));
-        pqxx::result r = tx.exec_params(
-            "DELETE FROM teams WHERE id = $1::uuid;",
-            id.data()
-        );
+        const pqxx::result r = tx.exec(pqxx::prepped{connection->Prepare(statements::DeleteTeam)},
+                                       pqxx::params{teamId.Binary()});
 
         tx.commit();
 
-        if (r.affected_rows() == 0) {
+        if (r.empty()) {
             throw std::runtime_error("Team not found");
         }
     }
@@ -25,6 +25,12 @@ public:
 
     void Delete(std::string id) override;//ya existe
     std::vector<std::shared_ptr<domain::Tournament>> ReadAll() override;
+    Page<domain::Tournament> ReadPage(const PageRequest& page) override;
+    void StreamAll(const std::function<void(const domain::Tournament&)>& consumer) override;
+    std::string UpdateReturningVersion(const domain::Tournament& entity) override;
+    std::string Version(std::string id) override;
+    std::string CollectionVersion() override;
+    std::optional<std::string> UpdateIfVersion(const domain::Tournament& entity, const std::vector<std::string>& versions) override;
 };
 
 #endif //TOURNAMENTS_TOURNAMENTREPOSITORY_HPP
\ No newline at end of file
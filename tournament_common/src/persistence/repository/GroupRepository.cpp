@@ -2,8 +2,10 @@
 // Created by root on 9/27/25.
 //
 
-#include <nlohmann/json.hpp>
-#include "domain/Utilities.hpp"
+#include <algorithm>
+#include "domain/JsonDecoder.hpp"
+#include "domain/JsonWriter.hpp"
+#include "domain/Uuid.hpp"
 #include "persistence/repository/GroupRepository.hpp"
 
 GroupRepository::GroupRepository(const std::shared_ptr<IDbConnectionProvider>& connectionProvider)
@@ -15,13 +17,14 @@ std::shared_ptr<domain::Group> GroupRepository::ReadById(std::string id) {
 
 std::string GroupRepository::Create (const domain::Group & entity) {
     auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
-    nlohmann::json groupBody = entity;
+    auto connection = pooled.As<PostgresConnection>();
+    const std::string groupBody = domain::ToJson(entity);
+    const auto tournamentId = domain::Uuid::Require(entity.TournamentId());
 
     pqxx::work tx(*(connection->connection));
     // Mantengo el prepared existente para insert si ya lo usabas en el setup
-    pqxx::result result = tx.exec(pqxx::prepped{"insert_group"},
-                                  pqxx::params{entity.TournamentId(), groupBody.dump()});
+    pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::InsertGroup)},
+                                  pqxx::params{tournamentId.Binary(), groupBody});
     tx.commit();
 
     return result[0]["id"].c_str();
@@ -29,21 +32,37 @@ std::string GroupRepository::Create (const domain::Group & entity) {
 
 std::string GroupRepository::Update (const domain::Group & entity) {
     auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
-    nlohmann::json groupBody = entity;
+    auto connection = pooled.As<PostgresConnection>();
+    const std::string groupBody = domain::ToJson(entity);
+    const auto groupId = domain::Uuid::Require(entity.Id());
 
     pqxx::work tx(*(connection->connection));
 
     // ✅ Sin prepared: actualiza el JSON completo y la fecha
     // Si quieres validar que pertenezca a un torneo especifico, agrega "AND tournament_id = $3"
     // y pasa entity.TournamentId() como tercer parametro.
+    // GROUP_TEAMS se sincroniza con document->'teams' en la misma sentencia.
     pqxx::result result = tx.exec_params(
-        "UPDATE groups "
-        "SET document = $2::jsonb, last_update_date = now() "
-        "WHERE id = $1::uuid "
-        "RETURNING id;",
-        entity.Id(),                   // $1
-        groupBody.dump()               // $2
+        "WITH updated AS ("
+        "  UPDATE groups "
+        "  SET document = $2::jsonb, last_update_date = now() "
+        "  WHERE id = $1::uuid "
+        "  RETURNING id, tournament_id, document"
+        "), members AS ("
+        "  SELECT updated.tournament_id, updated.id AS group_id, (team->>'id')::uuid AS team_id "
+        "  FROM updated, jsonb_array_elements(coalesce(updated.document->'teams', '[]'::jsonb)) team"
+        "), removed AS ("
+        "  DELETE FROM group_teams "
+        "  WHERE group_id IN (SELECT id FROM updated) "
+        "  AND NOT EXISTS (SELECT 1 FROM members WHERE members.team_id = group_teams.team_id)"
+        "), added AS ("
+        "  INSERT INTO group_teams (tournament_id, group_id, team_id) "
+        "  SELECT * FROM members "
+        "  WHERE NOT EXISTS (SELECT 1 FROM group_teams gt WHERE gt.group_id = members.group_id AND gt.team_id = members.team_id)"
+        ") "
+        "SELECT id FROM updated;",
+        groupId.Binary(),       // $1
+        groupBody               // $2
     );
 
     tx.commit();
@@ -56,13 +75,14 @@ std::string GroupRepository::Update (const domain::Group & entity) {
 }
 
 void GroupRepository::Delete(std::string id) {
+    const auto groupId = domain::Uuid::Require(id);
     auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    auto connection = pooled.As<PostgresConnection>();
 
     pqxx::work tx(*(connection->connection));
     pqxx::result r = tx.exec_params(
         "DELETE FROM groups WHERE id = $1::uuid;",
-        id
+        groupId.Binary()
     );
     tx.commit();
 
@@ -75,7 +95,7 @@ std::vector<std::shared_ptr<domain::Group>> GroupRepository::ReadAll() {
     std::vector<std::shared_ptr<domain::Group>> groups;
 
     auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    auto connection = pooled.As<PostgresConnection>();
 
     pqxx::work tx(*(connection->connection));
     pqxx::result result{tx.exec("select id, document->>'name' as name from groups")};
@@ -91,18 +111,18 @@ std::vector<std::shared_ptr<domain::Group>> GroupRepository::ReadAll() {
 }
 
 std::vector<std::shared_ptr<domain::Group>> GroupRepository::FindByTournamentId(const std::string_view& tournamentId) {
+    const auto tournament = domain::Uuid::Require(tournamentId);
     auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    auto connection = pooled.As<PostgresConnection>();
 
     pqxx::work tx(*(connection->connection));
-    pqxx::result result = tx.exec(pqxx::prepped{"select_groups_by_tournament"},
-                                  pqxx::params{tournamentId.data()});
+    pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::SelectGroupsByTournament)},
+                                  pqxx::params{tournament.Binary()});
     tx.commit();
 
     std::vector<std::shared_ptr<domain::Group>> groups;
     for (auto row : result) {
-        nlohmann::json groupDocument = nlohmann::json::parse(row["document"].c_str());
-        auto group = std::make_shared<domain::Group>(groupDocument);
+        auto group = std::make_shared<domain::Group>(domain::FromDocument<domain::Group>(row["document"].c_str()));
         group->Id() = row["id"].c_str();   // 🔧 usaba result[0]; ahora la fila actual
         groups.push_back(group);
     }
@@ -110,22 +130,58 @@ std::vector<std::shared_ptr<domain::Group>> GroupRepository::FindByTournamentId(
     return groups;
 }
 
+namespace {
+    Page<domain::Group> ToGroupsPage(const pqxx::result& result, const size_t limit) {
+        Page<domain::Group> groups;
+        for (size_t i = 0; i < std::min<size_t>(result.size(), limit); i++) {
+            auto group = std::make_shared<domain::Group>(domain::FromDocument<domain::Group>(result[i]["document"].c_str()));
+            group->Id() = result[i]["id"].c_str();
+            groups.items.push_back(group);
+        }
+        if (result.size() > limit) {
+            groups.nextCursor = cursor::Encode(result[limit - 1]["created_at"].c_str(), result[limit - 1]["id"].c_str());
+        }
+        return groups;
+    }
+}
+
+Page<domain::Group> GroupRepository::ReadPage(const PageRequest&) {
+    // groups are only listed within their tournament, see FindByTournamentId(tournamentId, page)
+    throw std::logic_error("groups are paged per tournament");
+}
+
+Page<domain::Group> GroupRepository::FindByTournamentId(const std::string_view& tournamentId, const PageRequest& page) {
+    const auto from = cursor::From(page);
+    const auto after = domain::Uuid::Require(from.id);
+    const auto tournament = domain::Uuid::Require(tournamentId);
+    auto pooled = connectionProvider->Connection();
+    auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::SelectGroupsByTournamentPage)},
+                                        pqxx::params{from.createdAt, after.Binary(), page.limit + 1, tournament.Binary()});
+    tx.commit();
+
+    return ToGroupsPage(result, page.limit);
+}
+
 std::shared_ptr<domain::Group> GroupRepository::FindByTournamentIdAndGroupId(const std::string_view& tournamentId,
                                                                              const std::string_view& groupId) {
+    const auto tournament = domain::Uuid::Require(tournamentId);
+    const auto groupUuid = domain::Uuid::Require(groupId);
     auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    auto connection = pooled.As<PostgresConnection>();
 
     pqxx::work tx(*(connection->connection));
-    pqxx::result result = tx.exec(pqxx::prepped{"select_group_by_tournamentid_groupid"},
-                                  pqxx::params{tournamentId.data(), groupId.data()});
+    pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::SelectGroupByTournamentIdGroupId)},
+                                  pqxx::params{tournament.Binary(), groupUuid.Binary()});
     tx.commit();
 
     if (result.empty()) {
         return nullptr;
     }
 
-    nlohmann::json groupDocument = nlohmann::json::parse(result[0]["document"].c_str());
-    auto group = std::make_shared<domain::Group>(groupDocument);
+    auto group = std::make_shared<domain::Group>(domain::FromDocument<domain::Group>(result[0]["document"].c_str()));
     group->Id() = result[0]["id"].c_str();
 
     return group;
@@ -133,20 +189,21 @@ std::shared_ptr<domain::Group> GroupRepository::FindByTournamentIdAndGroupId(con
 
 std::shared_ptr<domain::Group> GroupRepository::FindByTournamentIdAndTeamId(const std::string_view& tournamentId,
                                                                             const std::string_view& teamId) {
+    const auto tournament = domain::Uuid::Require(tournamentId);
+    const auto team = domain::Uuid::Require(teamId);
     auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    const auto connection = pooled.As<PostgresConnection>();
 
     pqxx::work tx(*(connection->connection));
-    const pqxx::result result = tx.exec(pqxx::prepped{"select_group_in_tournament"},
-                                        pqxx::params{tournamentId.data(), teamId.data()});
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::SelectGroupInTournament)},
+                                        pqxx::params{tournament.Binary(), team.Binary()});
     tx.commit();
 
     if (result.empty()) {
         return nullptr;
     }
 
-    nlohmann::json groupDocument = nlohmann::json::parse(result[0]["document"].c_str());
-    std::shared_ptr<domain::Group> group = std::make_shared<domain::Group>(groupDocument);
+    std::shared_ptr<domain::Group> group = std::make_shared<domain::Group>(domain::FromDocument<domain::Group>(result[0]["document"].c_str()));
     group->Id() = result[0]["id"].c_str();
 
     return group;
@@ -154,13 +211,105 @@ std::shared_ptr<domain::Group> GroupRepository::FindByTournamentIdAndTeamId(cons
 
 void GroupRepository::UpdateGroupAddTeam(const std::string_view& groupId,
                                          const std::shared_ptr<domain::Team> & team) {
-    nlohmann::json teamDocument = team;
+    const std::string teamDocument = domain::ToJson(team);
+    const auto group = domain::Uuid::Require(groupId);
 
     auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    const auto connection = pooled.As<PostgresConnection>();
 
     pqxx::work tx(*(connection->connection));
-    const pqxx::result result = tx.exec(pqxx::prepped{"update_group_add_team"},
-                                        pqxx::params{groupId.data(), teamDocument.dump()});
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::UpdateGroupAddTeam)},
+                                        pqxx::params{group.Binary(), teamDocument});
     tx.commit();
 }
+
+AddTeamsResult GroupRepository::AddTeams(const std::string_view& tournamentId, const std::string_view& groupId,
+                                         const std::vector<std::string>& teamIds) {
+    const auto tournament = domain::Uuid::Require(tournamentId);
+    const auto group = domain::Uuid::Require(groupId);
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    const auto addTeams = [&] {
+        pqxx::work tx(*(connection->connection));
+        pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::AddTeamsToGroup)},
+                                      pqxx::params{tournament.Binary(), group.Binary(), teamIds});
+        tx.commit();
+        return result;
+    };
+
+    pqxx::result result;
+    try {
+        result = addTeams();
+    } catch (const pqxx::unique_violation&) {
+        // a concurrent call assigned one of the teams after our snapshot was taken,
+        // running again reports which one as team_already_assigned
+        result = addTeams();
+    }
+
+    const std::string_view status = result[0]["status"].c_str();
+    AddTeamsResult added{AddTeamsStatus::Added, {}};
+    if (status == "tournament_not_found") {
+        added.status = AddTeamsStatus::TournamentNotFound;
+    } else if (status == "group_not_found") {
+        added.status = AddTeamsStatus::GroupNotFound;
+    } else if (status == "team_not_found") {
+        added.status = AddTeamsStatus::TeamNotFound;
+    } else if (status == "team_already_assigned") {
+        added.status = AddTeamsStatus::TeamAlreadyAssigned;
+    } else if (status == "group_full") {
+        added.status = AddTeamsStatus::GroupFull;
+    }
+    if (!result[0]["team_id"].is_null()) {
+        added.teamId = result[0]["team_id"].c_str();
+    }
+    return added;
+}
+
+size_t GroupRepository::CountTeams(const std::string_view& tournamentId) {
+    const auto tournament = domain::Uuid::Require(tournamentId);
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::CountTeamsInTournament)},
+                                        pqxx::params{tournament.Binary()});
+    tx.commit();
+
+    return result[0]["teams"].as<size_t>();
+}
+
+std::string GroupRepository::GroupVersion(const std::string_view& tournamentId, const std::string_view& groupId) {
+    const auto tournament = domain::Uuid::Require(tournamentId);
+    const auto group = domain::Uuid::Require(groupId);
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::SelectGroupVersion)},
+                                        pqxx::params{tournament.Binary(), group.Binary()});
+    tx.commit();
+
+    return result.empty() ? std::string{} : result[0]["version"].c_str();
+}
+
+std::optional<std::string> GroupRepository::UpdateIfVersion(const domain::Group& entity, const std::vector<std::string>& versions) {
+    const std::string groupBody = domain::ToJson(entity);
+    const auto groupId = domain::Uuid::Require(entity.Id());
+    const auto tournamentId = domain::Uuid::Require(entity.TournamentId());
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::UpdateGroupIfVersion)},
+                                        pqxx::params{groupId.Binary(), groupBody, tournamentId.Binary(), versions});
+    tx.commit();
+
+    if (!result[0]["found"].as<bool>()) {
+        throw std::runtime_error("Group not found");
+    }
+    if (result[0]["version"].is_null()) {
+        return std::nullopt;
+    }
+    return result[0]["version"].c_str();
+}
@@ -0,0 +1,42 @@
+#include <algorithm>
+#include "persistence/repository/OutboxRepository.hpp"
+
+OutboxRepository::OutboxRepository(const std::shared_ptr<IDbConnectionProvider>& connectionProvider)
+    : connectionProvider(connectionProvider) {}
+
+std::vector<OutboxEvent> OutboxRepository::Claim(const size_t limit, const std::chrono::milliseconds lease) {
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::ClaimOutboxEvents)},
+                                        pqxx::params{limit, static_cast<int64_t>(lease.count())});
+    tx.commit();
+
+    std::vector<OutboxEvent> events;
+    events.reserve(result.size());
+    for (const auto& row : result) {
+        events.push_back(OutboxEvent{row["id"].as<int64_t>(), row["queue"].c_str(), row["payload"].c_str()});
+    }
+    // update ... returning gives no order, publish in the order the events were written
+    std::ranges::sort(events, {}, &OutboxEvent::id);
+    return events;
+}
+
+void OutboxRepository::Delete(const std::vector<int64_t>& ids) {
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    tx.exec(pqxx::prepped{connection->Prepare(statements::DeleteOutboxEvents)}, pqxx::params{ids});
+    tx.commit();
+}
+
+void OutboxRepository::Release(const std::vector<int64_t>& ids) {
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    tx.exec(pqxx::prepped{connection->Prepare(statements::ReleaseOutboxEvents)}, pqxx::params{ids});
+    tx.commit();
+}
@@ -1,12 +1,15 @@
 //
 // Created by tsuny on 9/1/25.
 //
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
-#include <nlohmann/json.hpp>
 
 #include "persistence/repository/TournamentRepository.hpp"
-#include "domain/Utilities.hpp"
+#include "domain/JsonDecoder.hpp"
+#include "domain/JsonWriter.hpp"
+#include "domain/Uuid.hpp"
 #include "persistence/configuration/PostgresConnection.hpp"
 
 
@@ -14,19 +17,19 @@ TournamentRepository::TournamentRepository(std::shared_ptr<IDbConnectionProvider
 }
 
 std::shared_ptr<domain::Tournament> TournamentRepository::ReadById(std::string id) {
+    const auto tournamentId = domain::Uuid::Require(id);
     auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    const auto connection = pooled.As<PostgresConnection>();
 
 
     pqxx::work tx(*(connection->connection));
-    const pqxx::result result = tx.exec(pqxx::prepped{"select_tournament_by_id"}, id);
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::SelectTournamentById)}, pqxx::params{tournamentId.Binary()});
     tx.commit();
 
     if (result.empty()) {
         return nullptr;
     }
-    nlohmann::json rowTournament = nlohmann::json::parse(result.at(0)["document"].c_str());
-    auto tournament = std::make_shared<domain::Tournament>(rowTournament);
+    auto tournament = std::make_shared<domain::Tournament>(domain::FromDocument<domain::Tournament>(result.at(0)["document"].c_str()));
     tournament->Id() = result.at(0)["id"].c_str();
 
     return tournament;
@@ -35,12 +38,12 @@ std::shared_ptr<domain::Tournament> TournamentRepository::ReadById(std::string i
 
 std::string TournamentRepository::Create (const domain::Tournament & entity) {
 
-    const nlohmann::json tournamentDoc = entity;
+    const std::string tournamentDoc = domain::ToJson(entity);
 
     auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    const auto connection = pooled.As<PostgresConnection>();
     pqxx::work tx(*(connection->connection));
-    const pqxx::result result = tx.exec(pqxx::prepped{"insert_tournament"}, tournamentDoc.dump());
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::InsertTournament)}, tournamentDoc);
 
     tx.commit();
 
@@ -49,18 +52,21 @@ std::string TournamentRepository::Create (const domain::Tournament & entity) {
 
 
 std::string TournamentRepository::Update(const domain::Tournament& entity) {
+    UpdateReturningVersion(entity);
+    return domain::Uuid::Require(entity.Id()).ToString();
+}
+
+std::string TournamentRepository::UpdateReturningVersion(const domain::Tournament& entity) {
     auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    const auto connection = pooled.As<PostgresConnection>();
     pqxx::work tx(*(connection->connection));
 
     // Usa el id del parámetro de la URL, no del JSON
-    const nlohmann::json tournamentDoc = entity;
+    const std::string tournamentDoc = domain::ToJson(entity);
+    const auto tournamentId = domain::Uuid::Require(entity.Id());
 
-    pqxx::result r = tx.exec_params(
-        "UPDATE tournaments SET document = $1 WHERE id = $2::uuid RETURNING id;",
-        tournamentDoc.dump(),
-        entity.Id()  // ← Usa el método Id() de la clase, no el JSON
-    );
+    pqxx::result r = tx.exec(pqxx::prepped{connection->Prepare(statements::UpdateTournament)},
+                             pqxx::params{tournamentDoc, tournamentId.Binary()});  // ← Usa el método Id() de la clase, no el JSON
 
     tx.commit();
 
@@ -68,11 +74,11 @@ std::string TournamentRepository::Update(const domain::Tournament& entity) {
         throw std::runtime_error("Tournament not found");
     }
 
-    return r[0]["id"].c_str();
+    return r[0]["version"].c_str();
 }
 // ```
 //
-// El cambio clave: `SET document = $1` en lugar de `SET name = $1`, y `tournamentDoc.dump()` para guardar el JSON completo.
+// El cambio clave: `SET document = $1` en lugar de `SET name = $1`, y `tournamentDoc` para guardar el JSON completo.
 //
 // Recompila y prueba:
 // ```
@@ -90,18 +96,16 @@ std::string TournamentRepository::Update(const domain::Tournament& entity) {
 
 // Al final del archivo, agrega:
 void TournamentRepository::Delete(std::string id) {
+    const auto tournamentId = domain::Uuid::Require(id);
     auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    const auto connection = pooled.As<PostgresConnection>();
     pqxx::work tx(*(connection->connection));
 
-    pqxx::result r = tx.exec_params(
-        "DELETE FROM tournaments WHERE id = $1::uuid;",
-        id
-    );
+    pqxx::result r = tx.exec(pqxx::prepped{connection->Prepare(statements::DeleteTournament)}, pqxx::params{tournamentId.Binary()});
 
     tx.commit();
 
-    if (r.affected_rows() == 0) {
+    if (r.empty()) {
         throw std::runtime_error("Tournament not found");
     }
 }
@@ -109,19 +113,98 @@ std::vector<std::shared_ptr<domain::Tournament>> TournamentRepository::ReadAll()
     std::vector<std::shared_ptr<domain::Tournament>> tournaments;
 
     auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    const auto connection = pooled.As<PostgresConnection>();
 
     pqxx::work tx(*(connection->connection));
     const pqxx::result result{tx.exec("select id, document from tournaments")};
     tx.commit();
 
     for(auto row : result){
-        nlohmann::json rowTournament = nlohmann::json::parse(row["document"].c_str());
-        auto tournament = std::make_shared<domain::Tournament>(rowTournament);
+        auto tournament = std::make_shared<domain::Tournament>(domain::FromDocument<domain::Tournament>(row["document"].c_str()));
         tournament->Id() = row["id"].c_str();
 
         tournaments.push_back(tournament);
     }
 
     return tournaments;
-}
\ No newline at end of file
+}
+void TournamentRepository::StreamAll(const std::function<void(const domain::Tournament&)>& consumer) {
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    for (auto [id, document] : tx.stream<std::string_view, std::string_view>("select id, document from tournaments")) {
+        domain::Tournament tournament = domain::FromDocument<domain::Tournament>(document);
+        tournament.Id() = id;
+        consumer(tournament);
+    }
+    tx.commit();
+}
+
+Page<domain::Tournament> TournamentRepository::ReadPage(const PageRequest& page) {
+    const auto from = cursor::From(page);
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    const auto after = domain::Uuid::Require(from.id);
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::SelectTournamentsPage)},
+                                        pqxx::params{from.createdAt, after.Binary(), page.limit + 1});
+    tx.commit();
+
+    Page<domain::Tournament> tournaments;
+    for (size_t i = 0; i < std::min<size_t>(result.size(), page.limit); i++) {
+        auto tournament = std::make_shared<domain::Tournament>(domain::FromDocument<domain::Tournament>(result[i]["document"].c_str()));
+        tournament->Id() = result[i]["id"].c_str();
+        tournaments.items.push_back(tournament);
+    }
+    if (result.size() > page.limit) {
+        tournaments.nextCursor = cursor::Encode(result[page.limit - 1]["created_at"].c_str(), result[page.limit - 1]["id"].c_str());
+    }
+    return tournaments;
+}
+
+std::string TournamentRepository::Version(std::string id) {
+    const auto tournamentId = domain::Uuid::Require(id);
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::SelectTournamentVersion)},
+                                        pqxx::params{tournamentId.Binary()});
+    tx.commit();
+
+    return result.empty() ? std::string{} : result[0]["version"].c_str();
+}
+
+std::string TournamentRepository::CollectionVersion() {
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::SelectTournamentsVersion)}, pqxx::params{});
+    tx.commit();
+
+    return result[0]["version"].c_str();
+}
+
+std::optional<std::string> TournamentRepository::UpdateIfVersion(const domain::Tournament& entity,
+                                                                  const std::vector<std::string>& versions) {
+    const std::string tournamentDoc = domain::ToJson(entity);
+    const auto tournamentId = domain::Uuid::Require(entity.Id());
+    auto pooled = connectionProvider->Connection();
+    const auto connection = pooled.As<PostgresConnection>();
+
+    pqxx::work tx(*(connection->connection));
+    const pqxx::result result = tx.exec(pqxx::prepped{connection->Prepare(statements::UpdateTournamentIfVersion)},
+                                        pqxx::params{tournamentDoc, tournamentId.Binary(), versions});
+    tx.commit();
+
+    if (!result[0]["found"].as<bool>()) {
+        throw std::runtime_error("Tournament not found");
+    }
+    if (result[0]["version"].is_null()) {
+        return std::nullopt;
+    }
+    return result[0]["version"].c_str();
+}
@@ -0,0 +1,47 @@
+#ifndef CONSUMER_CONSUMER_CONFIGURATION_HPP
+#define CONSUMER_CONSUMER_CONFIGURATION_HPP
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <nlohmann/json.hpp>
+
+#include "cms/ConsumerOptions.hpp"
+
+namespace config {
+    struct ConsumerConfiguration {
+        // threads running the message handlers of every queue, 0 for one per hardware thread
+        size_t workers = 0;
+        // used for queues without an entry in queues
+        ConsumerOptions queueOptions;
+        std::map<std::string, ConsumerOptions, std::less<>> queues;
+        // how often throughput and lag are printed, 0 to not print them
+        std::chrono::seconds reportInterval{10};
+
+        [[nodiscard]] const ConsumerOptions& For(const std::string_view queue) const {
+            const auto found = queues.find(queue);
+            return found != queues.end() ? found->second : queueOptions;
+        }
+    };
+
+    inline void from_json(const nlohmann::json& json, ConsumerConfiguration& consumerConfiguration) {
+        consumerConfiguration.workers = json.value<size_t>("workers", 0);
+        consumerConfiguration.queueOptions.sessions = json.value<size_t>("sessionsPerQueue", 2);
+        consumerConfiguration.queueOptions.ackBatchSize = json.value<size_t>("ackBatchSize", 32);
+        consumerConfiguration.queueOptions.maxConcurrency = json.value<size_t>("maxConcurrency", 0);
+        // "queues": {"tournament.created": {"sessions": 4, "maxConcurrency": 8}}, unset keys keep the defaults above
+        const nlohmann::json queues = json.value("queues", nlohmann::json::object());
+        for (const auto& [queue, options] : queues.items()) {
+            const ConsumerOptions& defaults = consumerConfiguration.queueOptions;
+            consumerConfiguration.queues[queue] = {
+                options.value<size_t>("sessions", defaults.sessions),
+                options.value<size_t>("ackBatchSize", defaults.ackBatchSize),
+                options.value<size_t>("maxConcurrency", defaults.maxConcurrency)
+            };
+        }
+        consumerConfiguration.reportInterval = std::chrono::seconds(json.value<int64_t>("reportIntervalSeconds", 10));
+    }
+}
+#endif //CONSUMER_CONSUMER_CONFIGURATION_HPP
@@ -11,13 +11,19 @@
 #include <memory>
 #include <print>
 
+#include "configuration/ConsumerConfiguration.hpp"
 #include "configuration/DatabaseConfiguration.hpp"
 #include "cms/ConnectionManager.hpp"
 #include "persistence/repository/IRepository.hpp"
-#include "persistence/repository/TeamRepository.hpp"
+#include "persistence/repository/GroupRepository.hpp"
 #include "persistence/configuration/PostgresConnectionProvider.hpp"
 #include "persistence/repository/TournamentRepository.hpp"
 #include "cms/QueueMessageConsumer.hpp"
+#include "cms/WorkStealingPool.hpp"
+#include "handler/HandlerRegistry.hpp"
+#include "handler/TournamentCreatedHandler.hpp"
+#include "handler/TournamentDeletedHandler.hpp"
+#include "handler/TournamentUpdatedHandler.hpp"
 
 namespace config {
     inline std::shared_ptr<Hypodermic::Container> containerSetup() {
@@ -27,8 +33,8 @@ namespace config {
         nlohmann::json configuration;
         file >> configuration;
 
-        std::shared_ptr<PostgresConnectionProvider> postgressConnection = std::make_shared<PostgresConnectionProvider>(configuration["databaseConfig"]["connectionString"].get<std::string>(), configuration["databaseConfig"]["poolSize"].get<size_t>());
-        builder.registerInstance(postgressConnection).as<IDbConnectionProvider>();
+        std::shared_ptr<PostgresConnectionProvider> postgressConnection = std::make_shared<PostgresConnectionProvider>(configuration["databaseConfig"].get<DatabaseConfiguration>());
+        builder.registerInstance(postgressConnection).as<IDbConnectionProvider>().asSelf();
 
         builder.registerType<ConnectionManager>()
             .onActivated([configuration](Hypodermic::ComponentContext& context, const std::shared_ptr<ConnectionManager>& instance) {
@@ -36,20 +42,32 @@ namespace config {
             })
             .singleInstance();
 
+        const auto consumerConfiguration = std::make_shared<ConsumerConfiguration>(configuration.value("consumer", nlohmann::json::object()));
+        builder.registerInstance(consumerConfiguration);
+        // every queue's handlers run on this pool
+        builder.registerInstance(std::make_shared<WorkStealingPool>(consumerConfiguration->workers));
+
         builder.registerType<QueueMessageConsumer>();
-            // .onActivated([](Hypodermic::ComponentContext& , const std::shared_ptr<QueueMessageConsumer>& instance) {
-            //     instance->QueueName() = "tournament.created";
-            //     instance->start();
-            // }).singleInstance();
 
         // builder.registerType<QueueMessageProducer>().named("tournamentAddTeamQueue");
         // builder.registerType<QueueResolver>().as<IResolver<IQueueMessageProducer> >().named("queueResolver").
         //         singleInstance();
 
-        builder.registerType<TeamRepository>().as<IRepository<domain::Team, std::string_view>>().singleInstance();
+        builder.registerType<GroupRepository>().as<IGroupRepository>().singleInstance();
 
         builder.registerType<TournamentRepository>().as<IRepository<domain::Tournament, std::string>>().singleInstance();
 
+        builder.registerType<TournamentCreatedHandler>().singleInstance();
+        builder.registerType<TournamentUpdatedHandler>().singleInstance();
+        builder.registerType<TournamentDeletedHandler>().singleInstance();
+        builder.registerType<HandlerRegistry>()
+            .onActivated([](Hypodermic::ComponentContext& context, const std::shared_ptr<HandlerRegistry>& registry) {
+                registry->Register("tournament.created", context.resolve<TournamentCreatedHandler>());
+                registry->Register("tournament.updated", context.resolve<TournamentUpdatedHandler>());
+                registry->Register("tournament.deleted", context.resolve<TournamentDeletedHandler>());
+            })
+            .singleInstance();
+
         return builder.build();
     }
 }
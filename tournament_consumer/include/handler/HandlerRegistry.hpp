@@ -0,0 +1,40 @@
+#ifndef CONSUMER_HANDLER_REGISTRY_HPP
+#define CONSUMER_HANDLER_REGISTRY_HPP
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "handler/IMessageHandler.hpp"
+
+// Which handler serves which queue. Filled in ContainerSetup, main starts one QueueMessageConsumer
+// per registration, all on the shared worker pool.
+class HandlerRegistry {
+public:
+    struct Registration {
+        std::string queue;
+        std::shared_ptr<IMessageHandler> handler;
+    };
+
+    // A queue has exactly one handler, registering a second one is a setup error.
+    void Register(const std::string_view queue, std::shared_ptr<IMessageHandler> handler) {
+        for (const auto& registration : registrations) {
+            if (registration.queue == queue) {
+                throw std::logic_error("handler registered twice for " + std::string{queue});
+            }
+        }
+        registrations.push_back({std::string{queue}, std::move(handler)});
+    }
+
+    [[nodiscard]] const std::vector<Registration>& Registrations() const {
+        return registrations;
+    }
+
+private:
+    std::vector<Registration> registrations;
+};
+
+#endif //CONSUMER_HANDLER_REGISTRY_HPP
@@ -0,0 +1,27 @@
+#ifndef CONSUMER_IMESSAGE_HANDLER_HPP
+#define CONSUMER_IMESSAGE_HANDLER_HPP
+
+#include <string>
+
+// Handles the payload of one message of the queue it is registered for in the HandlerRegistry.
+// Runs on the shared worker pool, several messages at once, so implementations must be thread
+// safe. An exception is counted as a failed message and logged.
+class IMessageHandler {
+public:
+    virtual ~IMessageHandler() = default;
+    virtual void Handle(const std::string& payload) = 0;
+};
+
+// Handler of a typed event: Event::Decode turns the payload into the event, or throws when the
+// payload is malformed.
+template<typename Event>
+class IEventHandler : public IMessageHandler {
+public:
+    void Handle(const std::string& payload) final {
+        Handle(Event::Decode(payload));
+    }
+
+    virtual void Handle(const Event& event) = 0;
+};
+
+#endif //CONSUMER_IMESSAGE_HANDLER_HPP
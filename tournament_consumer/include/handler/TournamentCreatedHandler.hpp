@@ -0,0 +1,48 @@
+#ifndef CONSUMER_TOURNAMENT_CREATED_HANDLER_HPP
+#define CONSUMER_TOURNAMENT_CREATED_HANDLER_HPP
+
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <print>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "domain/Tournament.hpp"
+#include "handler/IMessageHandler.hpp"
+#include "handler/TournamentEvent.hpp"
+#include "persistence/repository/IGroupRepository.hpp"
+#include "persistence/repository/IRepository.hpp"
+
+// Reports a new tournament and whether enough teams are assigned to its groups to fill them. The
+// count is one index lookup on GROUP_TEAMS.
+class TournamentCreatedHandler : public IEventHandler<TournamentEvent> {
+    std::shared_ptr<IRepository<domain::Tournament, std::string>> tournamentRepository;
+    std::shared_ptr<IGroupRepository> groupRepository;
+
+public:
+    TournamentCreatedHandler(std::shared_ptr<IRepository<domain::Tournament, std::string>> tournamentRepository,
+                             std::shared_ptr<IGroupRepository> groupRepository)
+        : tournamentRepository(std::move(tournamentRepository)), groupRepository(std::move(groupRepository)) {}
+
+    void Handle(const TournamentEvent& event) override {
+        const auto tournament = tournamentRepository->ReadById(event.tournamentId);
+        if (!tournament) {
+            // deleted before the event got here, tournament.deleted follows
+            std::println("tournament created and already gone: {}", event.tournamentId);
+            return;
+        }
+
+        const auto& format = tournament->Format();
+        const size_t capacity = static_cast<size_t>(std::max(format.NumberOfGroups(), 1)) *
+                                static_cast<size_t>(std::max(format.MaxTeamsPerGroup(), 1));
+        const size_t assigned = groupRepository->CountTeams(event.tournamentId);
+        std::println("tournament created: {} ({}, {} groups of up to {} teams), {}",
+                     tournament->Name(), domain::toString(format.Type()), format.NumberOfGroups(), format.MaxTeamsPerGroup(),
+                     assigned >= capacity ? std::string{"enough teams assigned"}
+                                          : std::format("only {} of {} teams assigned", assigned, capacity));
+    }
+};
+
+#endif //CONSUMER_TOURNAMENT_CREATED_HANDLER_HPP
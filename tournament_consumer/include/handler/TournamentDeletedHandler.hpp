@@ -0,0 +1,32 @@
+#ifndef CONSUMER_TOURNAMENT_DELETED_HANDLER_HPP
+#define CONSUMER_TOURNAMENT_DELETED_HANDLER_HPP
+
+#include <memory>
+#include <print>
+#include <string>
+#include <utility>
+
+#include "domain/Tournament.hpp"
+#include "handler/IMessageHandler.hpp"
+#include "handler/TournamentEvent.hpp"
+#include "persistence/repository/IRepository.hpp"
+
+// Reports a deleted tournament. The event is written in the transaction of the delete, so the row
+// is expected to be gone.
+class TournamentDeletedHandler : public IEventHandler<TournamentEvent> {
+    std::shared_ptr<IRepository<domain::Tournament, std::string>> tournamentRepository;
+
+public:
+    explicit TournamentDeletedHandler(std::shared_ptr<IRepository<domain::Tournament, std::string>> tournamentRepository)
+        : tournamentRepository(std::move(tournamentRepository)) {}
+
+    void Handle(const TournamentEvent& event) override {
+        if (tournamentRepository->ReadById(event.tournamentId)) {
+            std::println("tournament deleted but still stored: {}", event.tournamentId);
+            return;
+        }
+        std::println("tournament deleted: {}", event.tournamentId);
+    }
+};
+
+#endif //CONSUMER_TOURNAMENT_DELETED_HANDLER_HPP
@@ -0,0 +1,21 @@
+#ifndef CONSUMER_TOURNAMENT_EVENT_HPP
+#define CONSUMER_TOURNAMENT_EVENT_HPP
+
+#include <stdexcept>
+#include <string>
+
+#include "domain/Uuid.hpp"
+
+// tournament.created, tournament.updated and tournament.deleted carry the tournament id as text.
+struct TournamentEvent {
+    std::string tournamentId;
+
+    static TournamentEvent Decode(const std::string& payload) {
+        if (!domain::Uuid::Parse(payload)) {
+            throw std::invalid_argument("malformed tournament event: " + payload);
+        }
+        return {payload};
+    }
+};
+
+#endif //CONSUMER_TOURNAMENT_EVENT_HPP
@@ -0,0 +1,35 @@
+#ifndef CONSUMER_TOURNAMENT_UPDATED_HANDLER_HPP
+#define CONSUMER_TOURNAMENT_UPDATED_HANDLER_HPP
+
+#include <memory>
+#include <print>
+#include <string>
+#include <utility>
+
+#include "domain/Tournament.hpp"
+#include "handler/IMessageHandler.hpp"
+#include "handler/TournamentEvent.hpp"
+#include "persistence/repository/IRepository.hpp"
+
+// Reports the state of a tournament after a change. Several updates in a row may all report the
+// newest state, the event only names the tournament.
+class TournamentUpdatedHandler : public IEventHandler<TournamentEvent> {
+    std::shared_ptr<IRepository<domain::Tournament, std::string>> tournamentRepository;
+
+public:
+    explicit TournamentUpdatedHandler(std::shared_ptr<IRepository<domain::Tournament, std::string>> tournamentRepository)
+        : tournamentRepository(std::move(tournamentRepository)) {}
+
+    void Handle(const TournamentEvent& event) override {
+        const auto tournament = tournamentRepository->ReadById(event.tournamentId);
+        if (!tournament) {
+            std::println("tournament updated and already gone: {}", event.tournamentId);
+            return;
+        }
+        const auto& format = tournament->Format();
+        std::println("tournament updated: {} ({}, {} groups of up to {} teams)", tournament->Name(),
+                     domain::toString(format.Type()), format.NumberOfGroups(), format.MaxTeamsPerGroup());
+    }
+};
+
+#endif //CONSUMER_TOURNAMENT_UPDATED_HANDLER_HPP
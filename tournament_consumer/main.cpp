@@ -2,27 +2,73 @@
 // Created by tomas on 9/6/25.
 //
 #include <activemq/library/ActiveMQCPP.h>
-#include <thread>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <print>
+#include <string>
+#include <vector>
 
 #include "configuration/ContainerSetup.hpp"
 
 int main() {
+    // SIGINT/SIGTERM are taken with sigtimedwait below, block them before any thread starts so none
+    // of the broker or pool threads receives them
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
     activemq::library::ActiveMQCPP::initializeLibrary();
     {
         std::println("before container");
         const auto container = config::containerSetup();
         std::println("after container");
+        container->resolve<PostgresConnectionProvider>()->WaitUntilReady();
+        std::println("database pool ready");
 
-        std::thread tournamentCreatedThread([&] {
-            auto listener = container->resolve<QueueMessageConsumer>();
-            listener->Start("tournament.created");
-        });
+        const auto consumerConfiguration = container->resolve<config::ConsumerConfiguration>();
+        const auto workers = container->resolve<WorkStealingPool>();
+        std::vector<std::shared_ptr<QueueMessageConsumer>> consumers;
+        for (const auto& [queue, handler] : container->resolve<HandlerRegistry>()->Registrations()) {
+            const ConsumerOptions& options = consumerConfiguration->For(queue);
+            auto consumer = container->resolve<QueueMessageConsumer>();
+            consumer->Start(queue, [handler](const std::string& payload) { handler->Handle(payload); }, options);
+            std::println("consuming {} with {} sessions, at most {} handlers at once", queue, options.sessions,
+                         options.maxConcurrency > 0 ? std::to_string(options.maxConcurrency) : "unlimited");
+            consumers.push_back(std::move(consumer));
+        }
+        std::println("{} workers shared by {} queues", workers->ThreadCount(), consumers.size());
 
-        tournamentCreatedThread.join();
-        // while (true) {
-        //     std::this_thread::sleep_for(std::chrono::seconds(5));
-        // }
+        const auto interval = consumerConfiguration->reportInterval.count() > 0
+                                  ? consumerConfiguration->reportInterval
+                                  : std::chrono::seconds(3600);
+        timespec timeout{static_cast<time_t>(interval.count()), 0};
+        std::vector<uint64_t> processed;
+        for (const auto& consumer : consumers) {
+            processed.push_back(consumer->Processed());
+        }
+        while (sigtimedwait(&stopSignals, nullptr, &timeout) < 0) {
+            if (errno != EAGAIN || consumerConfiguration->reportInterval.count() == 0) {
+                continue;
+            }
+            for (size_t i = 0; i < consumers.size(); i++) {
+                const uint64_t total = consumers[i]->Processed();
+                std::println("{}: {:.1f} msg/s, lag {} ms", consumers[i]->QueueName(),
+                             static_cast<double>(total - processed[i]) / static_cast<double>(interval.count()),
+                             consumers[i]->LastLag().count());
+                processed[i] = total;
+            }
+        }
+        std::println("stopping");
+        for (const auto& consumer : consumers) {
+            consumer->Stop();
+        }
     }
     activemq::library::ActiveMQCPP::shutdownLibrary();
     return 0;
-}
\ No newline at end of file
+}
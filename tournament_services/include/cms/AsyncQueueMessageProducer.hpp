@@ -0,0 +1,133 @@
+#ifndef SERVICE_ASYNC_QUEUE_MESSAGE_PRODUCER_HPP
+#define SERVICE_ASYNC_QUEUE_MESSAGE_PRODUCER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cms/CMSException.h>
+
+#include "IQueueMessageProducer.hpp"
+#include "cms/BackpressureQueue.hpp"
+#include "cms/ConnectionManager.hpp"
+#include "cms/TransactedSender.hpp"
+#include "configuration/PublisherConfiguration.hpp"
+#include "metrics/Metrics.hpp"
+
+// Publishes events from a background thread so the request threads never wait on the broker.
+// SendMessage() only puts the event on a bounded lock free queue; the sender thread drains it in
+// batches of up to batchSize, each sent on a transacted session and committed at once. When the
+// queue is full the configured backpressure policy decides between waiting and dropping.
+//
+// A batch the broker rejects is retried with backoff on a new session, so events are delivered at
+// least once and in order per queue. Destruction stops accepting events and keeps delivering the
+// queued ones for up to shutdownTimeout.
+class AsyncQueueMessageProducer : public IQueueMessageProducer {
+    using Clock = std::chrono::steady_clock;
+
+    struct Event {
+        std::string message;
+        std::string queue;
+    };
+
+    config::PublisherConfiguration configuration;
+    BackpressureQueue<Event> events;
+    // written before Stop(), read by the sender after it saw the queue stopping
+    Clock::time_point shutdownDeadline;
+
+    // used by the sender thread only
+    TransactedSender transactedSender;
+
+    metrics::Counter dropped = metrics::Registry::Instance().AddCounter(
+        "broker_events_dropped_total", "Events discarded by the backpressure policy or at shutdown.");
+    metrics::Counter sendFailures = metrics::Registry::Instance().AddCounter(
+        "broker_send_failures_total", "Messages the broker did not accept.");
+    metrics::Histogram batchTime = metrics::Registry::Instance().AddHistogram(
+        "broker_batch_duration_seconds", "Time to send and commit one batch of events.");
+
+    // declared last, started once everything above is constructed
+    std::thread sender;
+
+public:
+    AsyncQueueMessageProducer(const std::shared_ptr<ConnectionManager>& connectionManager,
+                              const std::shared_ptr<config::PublisherConfiguration>& configuration)
+        : configuration(*configuration),
+          events(configuration->queueCapacity, configuration->backpressure, configuration->blockTimeout),
+          transactedSender(connectionManager), sender([this] { Run(); }) {}
+
+    ~AsyncQueueMessageProducer() override {
+        shutdownDeadline = Clock::now() + configuration.shutdownTimeout;
+        events.Stop();
+        sender.join();
+    }
+
+    AsyncQueueMessageProducer(const AsyncQueueMessageProducer&) = delete;
+    AsyncQueueMessageProducer& operator=(const AsyncQueueMessageProducer&) = delete;
+
+    void SendMessage(const std::string_view& message, const std::string_view& queue) override {
+        Event event{std::string{message}, std::string{queue}};
+        const auto [queued, evicted] = events.Push(event);
+        if (const size_t lost = evicted + (queued ? 0 : 1); lost > 0) {
+            dropped.Add(lost);
+        }
+    }
+
+    [[nodiscard]] size_t Pending() const {
+        return events.Size();
+    }
+
+private:
+    void Run() {
+        std::vector<Event> batch;
+        batch.reserve(configuration.batchSize);
+        while (true) {
+            if (events.PopBatch(batch, configuration.batchSize) > 0) {
+                Deliver(batch);
+                batch.clear();
+                continue;
+            }
+            if (events.Size() > 0) {
+                // a push claimed its cell and is still filling it
+                std::this_thread::yield();
+                continue;
+            }
+            if (!events.WaitForValues()) {
+                break;
+            }
+        }
+        transactedSender.Reset();
+    }
+
+    void Deliver(const std::vector<Event>& batch) {
+        auto backoff = std::chrono::milliseconds(50);
+        while (true) {
+            try {
+                const metrics::Timer timer{batchTime};
+                SendBatch(batch);
+                return;
+            } catch (const cms::CMSException&) {
+                sendFailures.Add(batch.size());
+                transactedSender.Reset();
+            }
+            if (events.Stopping() && Clock::now() >= shutdownDeadline) {
+                dropped.Add(batch.size());
+                return;
+            }
+            events.Pause(backoff);
+            backoff = std::min(backoff * 2, std::chrono::milliseconds(5000));
+        }
+    }
+
+    void SendBatch(const std::vector<Event>& batch) {
+        for (const auto& event : batch) {
+            transactedSender.Send(event.queue, event.message);
+        }
+        transactedSender.Commit();
+    }
+};
+
+#endif //SERVICE_ASYNC_QUEUE_MESSAGE_PRODUCER_HPP
@@ -0,0 +1,129 @@
+#ifndef SERVICE_OUTBOX_RELAY_HPP
+#define SERVICE_OUTBOX_RELAY_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cms/IBatchSender.hpp"
+#include "configuration/OutboxConfiguration.hpp"
+#include "metrics/Metrics.hpp"
+#include "persistence/repository/IOutboxRepository.hpp"
+
+// Publishes the events the repositories write to OUTBOX. Each round claims a batch for
+// claimTimeout (relays of other instances take other rows), sends it in one broker transaction and
+// deletes the rows once the broker accepted them. The claim is committed before sending, so a
+// broker that hangs holds no database connection or row lock. A failure releases the rows for the
+// next round, so every event is delivered at least once; a crash after the broker commit, or a send
+// that outlives its claim, delivers the batch twice.
+class OutboxRelay {
+    std::shared_ptr<IOutboxRepository> repository;
+    std::shared_ptr<IBatchSender> sender;
+    config::OutboxConfiguration configuration;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    metrics::Counter published = metrics::Registry::Instance().AddCounter(
+        "outbox_events_published_total", "Outbox events handed to the broker.");
+    metrics::Counter failures = metrics::Registry::Instance().AddCounter(
+        "outbox_relay_failures_total", "Relay rounds that failed and left their events in the outbox.");
+    metrics::Histogram batchTime = metrics::Registry::Instance().AddHistogram(
+        "outbox_batch_duration_seconds", "Time to claim, publish and delete one outbox batch.");
+
+    // declared last, started by Start() once everything above is constructed
+    std::thread worker;
+
+    void Run() {
+        auto delay = configuration.pollInterval;
+        while (true) {
+            size_t relayed = 0;
+            try {
+                const metrics::Timer timer{batchTime};
+                relayed = RelayBatch();
+                delay = configuration.pollInterval;
+            } catch (const std::exception&) {
+                failures.Add();
+                delay = std::min(delay * 2, configuration.maxBackoff);
+            }
+
+            std::unique_lock lock(mutex);
+            // a full batch means more are probably waiting
+            if (!stopping && relayed < configuration.batchSize) {
+                wake.wait_for(lock, delay, [this] { return stopping; });
+            }
+            if (stopping) {
+                break;
+            }
+        }
+        sender->Reset();
+    }
+
+public:
+    OutboxRelay(std::shared_ptr<IOutboxRepository> repository, std::shared_ptr<IBatchSender> sender,
+                const std::shared_ptr<config::OutboxConfiguration>& configuration)
+        : repository(std::move(repository)), sender(std::move(sender)), configuration(*configuration) {}
+
+    // Events still in the outbox stay there, the next start publishes them.
+    ~OutboxRelay() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    OutboxRelay(const OutboxRelay&) = delete;
+    OutboxRelay& operator=(const OutboxRelay&) = delete;
+
+    // Publishes what is left in the outbox and keeps relaying until destruction.
+    void Start() {
+        worker = std::thread([this] { Run(); });
+    }
+
+    // Publishes one batch and returns its size. Throws if the database or the broker fails, the
+    // claimed rows are released then (or their claim lapses if releasing fails too).
+    size_t RelayBatch() {
+        const std::vector<OutboxEvent> events = repository->Claim(configuration.batchSize, configuration.claimTimeout);
+        if (events.empty()) {
+            return 0;
+        }
+        std::vector<int64_t> ids;
+        ids.reserve(events.size());
+        for (const auto& event : events) {
+            ids.push_back(event.id);
+        }
+
+        try {
+            for (const auto& event : events) {
+                sender->Send(event.queue, event.payload);
+            }
+            sender->Commit();
+        } catch (const std::exception&) {
+            sender->Reset();
+            try {
+                repository->Release(ids);
+            } catch (const std::exception&) {
+            }
+            throw;
+        }
+        // failing here republishes the batch once the claim lapses
+        repository->Delete(ids);
+
+        published.Add(events.size());
+        return events.size();
+    }
+};
+
+#endif //SERVICE_OUTBOX_RELAY_HPP
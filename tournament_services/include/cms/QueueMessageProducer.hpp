@@ -5,25 +5,48 @@
 #ifndef SERVICE_MESSAGE_PRODUCER_HPP
 #define SERVICE_MESSAGE_PRODUCER_HPP
 
+#include <string>
 #include <string_view>
 #include <memory>
+#include <cms/CMSException.h>
+#include <cms/TextMessage.h>
 
 #include "IQueueMessageProducer.hpp"
 #include "cms/ConnectionManager.hpp"
+#include "metrics/Metrics.hpp"
 
 class QueueMessageProducer: public IQueueMessageProducer {
     std::shared_ptr<ConnectionManager> connectionManager;
+    metrics::Histogram sendTime = metrics::Registry::Instance().AddHistogram(
+        "broker_send_duration_seconds", "Time to send one message to the broker.");
+    metrics::Counter sendFailures = metrics::Registry::Instance().AddCounter(
+        "broker_send_failures_total", "Messages the broker did not accept.");
 public:
     explicit QueueMessageProducer(const std::shared_ptr<ConnectionManager>& connectionManager) : connectionManager(connectionManager){}
 
     void SendMessage(const std::string_view& message, const std::string_view& queue) override {
-        auto session = connectionManager->CreateSession();
-        const auto destination = std::unique_ptr<cms::Destination>(session->createQueue(queue.data()));
-        auto producer = std::unique_ptr<cms::MessageProducer>(session->createProducer(destination.get()));
-        producer->setDeliveryMode( cms::DeliveryMode::NON_PERSISTENT );
+        const metrics::Timer timer{sendTime};
+        try {
+            Send(message, queue);
+        } catch (...) {
+            sendFailures.Add();
+            throw;
+        }
+    }
 
-        const auto brokerMessage = std::unique_ptr<cms::TextMessage>(session->createTextMessage(message.data()));
-        producer->send(brokerMessage.get());
+private:
+    // The session and producer come from the calling thread's cache, a send costs one broker round
+    // trip instead of three. A failed send may have broken the session, so it is dropped and the next
+    // send on this thread opens a new one.
+    void Send(const std::string_view& message, const std::string_view& queue) {
+        try {
+            auto [session, producer] = connectionManager->Producer(queue);
+            const auto brokerMessage = std::unique_ptr<cms::TextMessage>(session.createTextMessage(std::string{message}));
+            producer.send(brokerMessage.get());
+        } catch (const cms::CMSException&) {
+            connectionManager->DiscardThreadCache();
+            throw;
+        }
     }
 };
 
@@ -7,6 +7,7 @@
 
 #include <Hypodermic/Hypodermic.h>
 #include <memory>
+#include <string>
 
 #include "configuration/IResolver.hpp"
 #include "cms/IQueueMessageProducer.hpp"
@@ -18,12 +19,12 @@ public:
 
     std::shared_ptr<IQueueMessageProducer> Resolve(const std::string_view& key) override {
         auto cont = container.lock();
-        return cont->resolveNamed<QueueMessageProducer>(key.data());
+        return cont->resolveNamed<IQueueMessageProducer>(std::string{key});
     }
 
     std::shared_ptr<IQueueMessageProducer> Resolve() override{
         auto cont = container.lock();
-        return cont->resolve<QueueMessageProducer>();
+        return cont->resolve<IQueueMessageProducer>();
     }
 };
 #endif //SERVICE_QUEUE_RESOLVER_HPP
\ No newline at end of file
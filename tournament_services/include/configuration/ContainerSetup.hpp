@@ -11,21 +11,30 @@
 #include <memory>
 
 #include "persistence/repository/IRepository.hpp"
+#include "persistence/repository/ITeamRepository.hpp"
 #include "persistence/repository/TeamRepository.hpp"
 #include "RunConfiguration.hpp"
+#include "configuration/DatabaseConfiguration.hpp"
+#include "configuration/OutboxConfiguration.hpp"
+#include "configuration/PublisherConfiguration.hpp"
 #include "cms/ConnectionManager.hpp"
 #include "delegate/TeamDelegate.hpp"
 #include "controller/TeamController.hpp"
 #include "controller/TournamentController.hpp"
 #include "delegate/TournamentDelegate.hpp"
+#include "executor/DbExecutor.hpp"
 #include "persistence/configuration/PostgresConnectionProvider.hpp"
 #include "persistence/repository/TournamentRepository.hpp"
 #include "persistence/repository/GroupRepository.hpp"
-#include "cms/QueueMessageProducer.hpp"
+#include "persistence/repository/OutboxRepository.hpp"
+#include "cms/AsyncQueueMessageProducer.hpp"
+#include "cms/OutboxRelay.hpp"
+#include "cms/TransactedSender.hpp"
 #include "cms/QueueResolver.hpp"
 #include "delegate/IGroupDelegate.hpp"
 #include "delegate/GroupDelegate.hpp"
 #include "controller/GroupController.hpp"
+#include "controller/MetricsController.hpp"
 
 namespace config {
     inline std::shared_ptr<Hypodermic::Container> containerSetup() {
@@ -37,10 +46,13 @@ namespace config {
         std::shared_ptr<RunConfiguration> appConfig = std::make_shared<RunConfiguration>(configuration["runConfig"]);
         builder.registerInstance(appConfig);
 
-        std::shared_ptr<PostgresConnectionProvider> postgressConnection = std::make_shared<PostgresConnectionProvider>(
-            configuration["databaseConfig"]["connectionString"].get<std::string>(),
-            configuration["databaseConfig"]["poolSize"].get<size_t>());
-        builder.registerInstance(postgressConnection).as<IDbConnectionProvider>();
+        const auto databaseConfiguration = configuration["databaseConfig"].get<DatabaseConfiguration>();
+        std::shared_ptr<PostgresConnectionProvider> postgressConnection = std::make_shared<PostgresConnectionProvider>(databaseConfiguration);
+        builder.registerInstance(postgressConnection).as<IDbConnectionProvider>().asSelf();
+
+        // one database thread per connection the pool can open: fewer would leave connections idle
+        // while requests queue, more would only wait on the pool
+        builder.registerInstance(std::make_shared<DbExecutor>(databaseConfiguration.maxPoolSize, appConfig->maxQueuedRequests));
 
         builder.registerType<ConnectionManager>()
             .onActivated([configuration](Hypodermic::ComponentContext&, const std::shared_ptr<ConnectionManager>& instance) {
@@ -48,11 +60,29 @@ namespace config {
             })
             .singleInstance();
 
-        builder.registerType<QueueMessageProducer>().named("tournamentAddTeamQueue");
+        builder.registerInstance(std::make_shared<OutboxConfiguration>(configuration["activemq"].value("outbox", nlohmann::json::object())));
+        // tournament events are committed to the outbox with the change, the relay publishes them
+        builder.registerType<OutboxRepository>().as<IOutboxRepository>().singleInstance();
+        // persistent: the outbox rows are gone once the broker accepted them
+        builder.registerInstanceFactory([](Hypodermic::ComponentContext& context) {
+            return std::make_shared<TransactedSender>(context.resolve<ConnectionManager>(), cms::DeliveryMode::PERSISTENT);
+        }).as<IBatchSender>();
+        builder.registerType<OutboxRelay>().singleInstance();
+
+        // queues outside the outbox publish through the background sender, request threads never wait
+        // on the broker
+        builder.registerInstance(std::make_shared<PublisherConfiguration>(configuration["activemq"].value("publisher", nlohmann::json::object())));
+        builder.registerType<AsyncQueueMessageProducer>()
+                .as<IQueueMessageProducer>()
+                .named<IQueueMessageProducer>("tournamentAddTeamQueue")
+                .singleInstance();
         builder.registerType<QueueResolver>().as<IResolver<IQueueMessageProducer> >().named("queueResolver").
                 singleInstance();
 
-        builder.registerType<TeamRepository>().as<IRepository<domain::Team, std::string_view> >().singleInstance();
+        builder.registerType<TeamRepository>()
+                .as<IRepository<domain::Team, std::string_view> >()
+                .as<ITeamRepository>()
+                .singleInstance();
         builder.registerType<GroupRepository>().as<IGroupRepository>().singleInstance();
 
         builder.registerType<TeamDelegate>().as<ITeamDelegate>().singleInstance();
@@ -69,6 +99,8 @@ namespace config {
         builder.registerType<GroupDelegate>().as<IGroupDelegate>().singleInstance();
         builder.registerType<GroupController>().singleInstance();
 
+        builder.registerType<MetricsController>().singleInstance();
+
         return builder.build();
     }
 }
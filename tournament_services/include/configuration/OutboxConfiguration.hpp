@@ -0,0 +1,27 @@
+#ifndef SERVICE_OUTBOX_CONFIGURATION_HPP
+#define SERVICE_OUTBOX_CONFIGURATION_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <nlohmann/json.hpp>
+
+namespace config {
+    struct OutboxConfiguration {
+        // events claimed, published and committed together
+        size_t batchSize = 100;
+        // how long a claimed batch is held for this relay; past it another relay may publish it again,
+        // keep it above the broker send timeout
+        std::chrono::milliseconds claimTimeout{60000};
+        // pause between polls once the outbox is empty, doubled up to maxBackoff while failing
+        std::chrono::milliseconds pollInterval{200};
+        std::chrono::milliseconds maxBackoff{5000};
+    };
+
+    inline void from_json(const nlohmann::json& json, OutboxConfiguration& outboxConfiguration) {
+        outboxConfiguration.batchSize = std::max<size_t>(json.value<size_t>("batchSize", 100), 1);
+        outboxConfiguration.claimTimeout = std::chrono::milliseconds(json.value<int64_t>("claimTimeoutMs", 60000));
+        outboxConfiguration.pollInterval = std::chrono::milliseconds(json.value<int64_t>("pollIntervalMs", 200));
+        outboxConfiguration.maxBackoff = std::chrono::milliseconds(json.value<int64_t>("maxBackoffMs", 5000));
+    }
+}
+#endif //SERVICE_OUTBOX_CONFIGURATION_HPP
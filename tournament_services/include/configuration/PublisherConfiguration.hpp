@@ -0,0 +1,42 @@
+#ifndef SERVICE_PUBLISHER_CONFIGURATION_HPP
+#define SERVICE_PUBLISHER_CONFIGURATION_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <nlohmann/json.hpp>
+
+#include "cms/BackpressureQueue.hpp"
+
+namespace config {
+    struct PublisherConfiguration {
+        // events waiting for the sender thread, rounded up to a power of two
+        size_t queueCapacity = 4096;
+        // events sent in one broker transaction
+        size_t batchSize = 64;
+        // what SendMessage does when the event queue is full
+        Backpressure backpressure = Backpressure::Block;
+        std::chrono::milliseconds blockTimeout{100};
+        // how long shutdown keeps trying to deliver what is still queued
+        std::chrono::milliseconds shutdownTimeout{5000};
+    };
+
+    inline void from_json(const nlohmann::json& json, PublisherConfiguration& publisherConfiguration) {
+        publisherConfiguration.queueCapacity = json.value<size_t>("queueCapacity", 4096);
+        publisherConfiguration.batchSize = std::max<size_t>(json.value<size_t>("batchSize", 64), 1);
+        const auto backpressure = json.value<std::string>("backpressure", "block");
+        if (backpressure == "block") {
+            publisherConfiguration.backpressure = Backpressure::Block;
+        } else if (backpressure == "dropNewest") {
+            publisherConfiguration.backpressure = Backpressure::DropNewest;
+        } else if (backpressure == "dropOldest") {
+            publisherConfiguration.backpressure = Backpressure::DropOldest;
+        } else {
+            throw std::invalid_argument("unknown backpressure policy: " + backpressure);
+        }
+        publisherConfiguration.blockTimeout = std::chrono::milliseconds(json.value<int64_t>("blockTimeoutMs", 100));
+        publisherConfiguration.shutdownTimeout = std::chrono::milliseconds(json.value<int64_t>("shutdownTimeoutMs", 5000));
+    }
+}
+#endif //SERVICE_PUBLISHER_CONFIGURATION_HPP
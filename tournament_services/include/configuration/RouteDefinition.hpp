@@ -7,9 +7,22 @@
 
 #include <crow.h>
 #include <Hypodermic/Container.h>
+#include <algorithm>
+#include <array>
+#include <format>
 #include <vector>
 #include <functional>
+#include <exception>
+#include <type_traits>
 #include <string>
+#include <string_view>
+
+#include "configuration/RunConfiguration.hpp"
+#include "controller/Compression.hpp"
+#include "controller/ContentNegotiation.hpp"
+#include "executor/DbExecutor.hpp"
+#include "metrics/Metrics.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
 
 // Route definition storage
 struct RouteDefinition {
@@ -23,36 +36,128 @@ inline std::vector<RouteDefinition> &routeRegistry() {
     return registry;
 }
 
+template<typename Method>
+inline constexpr bool unmatchedControllerMethod = false;
+
+// Calls the controller method with the route parameters, optionally preceded by the request. A method
+// that takes neither fails to compile at its REGISTER_ROUTE instead of throwing on the first request.
 template<typename Controller, typename Method, typename... Args>
 auto invokeController(Controller* controller, Method method, const crow::request& request, Args&&... args) {
-    if constexpr(std::is_invocable_v<Method, Controller*>) {
-        return (controller->*method)();
-    }
-    else if constexpr( std::is_invocable_v<Method, Controller*, Args...>) {
+    if constexpr (std::is_invocable_v<Method, Controller*, Args...>) {
         return (controller->*method)(std::forward<Args>(args)...);
+    } else if constexpr (std::is_invocable_v<Method, Controller*, const crow::request&, Args...>) {
+        return (controller->*method)(request, std::forward<Args>(args)...);
+    } else {
+        static_assert(unmatchedControllerMethod<Method>,
+                      "controller method must take the route parameters, optionally preceded by const crow::request&");
+    }
+}
+
+// Latency and responses by status class of one route, registered when the route is bound. The time
+// runs from the crow thread receiving the request to the response being ended, queueing included.
+class RouteMetrics {
+    metrics::Histogram latency;
+    std::array<metrics::Counter, 5> responses;
+
+public:
+    RouteMetrics(const std::string_view path, const crow::HTTPMethod method) {
+        auto& registry = metrics::Registry::Instance();
+        const std::string labels = metrics::Label("method", crow::method_name(method)) + "," + metrics::Label("route", path);
+        latency = registry.AddHistogram("http_request_duration_seconds", "Time from receiving a request to ending its response.", labels);
+        for (size_t i = 0; i < responses.size(); i++) {
+            responses[i] = registry.AddCounter("http_responses_total", "Responses sent, by status class.",
+                                               labels + "," + metrics::Label("status", std::format("{}xx", i + 1)));
+        }
     }
-    else if constexpr( std::is_invocable_v<Method, Controller*, const crow::request&>) {
-        return (controller->*method)(request);
+
+    void Record(const int code, const metrics::Clock::time_point received) const {
+        latency.Observe(metrics::Clock::now() - received);
+        responses[std::clamp(code / 100, 1, 5) - 1].Add();
     }
-    if constexpr(std::is_invocable_v<Method, Controller*, const crow::request&, Args...>) {
-        return (controller->*method)(request, std::forward<Args>(args)...);
+};
+
+// Everything a route does on the database thread: response format, controller, compression.
+// Exceptions are answered here, there is no crow handler above this frame to catch them.
+template<typename Controller, typename Method, typename... Args>
+crow::response dispatchRoute(Controller* controller, Method method, const crow::request& request, const size_t minCompressSize, Args&&... args) {
+    const ResponseFormatScope responseFormat{AcceptedFormat(request.get_header_value("accept"))};
+    crow::response response;
+    try {
+        response = invokeController(controller, method, request, std::forward<Args>(args)...);
+    } catch (const ConnectionPoolExhausted& e) {
+        return crow::response{crow::SERVICE_UNAVAILABLE, e.what()};
+    } catch (const std::exception& e) {
+        CROW_LOG_ERROR << "unhandled exception in " << request.url << ": " << e.what();
+        return crow::response{crow::INTERNAL_SERVER_ERROR};
+    } catch (...) {
+        // anything escaping here would terminate the database thread and the process with it
+        CROW_LOG_ERROR << "unhandled non standard exception in " << request.url;
+        return crow::response{crow::INTERNAL_SERVER_ERROR};
+    }
+    Compress(request, response, minCompressSize);
+    return response;
+}
+
+// io context of the connection a request came in on, null when it did not come from one. crow
+// renamed the member from io_service to io_context.
+template<typename Request>
+auto* connectionIoContext(const Request& request) {
+    if constexpr (requires { request.io_context; }) {
+        return request.io_context;
+    } else {
+        return request.io_service;
     }
-    else  {
-        throw std::runtime_error("Controller does not exist");
+}
+
+// Ends the response on the I/O thread of its connection. crow's connection state is not thread
+// safe, a database thread only builds the response and hands end() back. Requests that do not come
+// from a connection (tests) are ended in place.
+inline void endOnConnectionThread(const crow::request& request, crow::response& response) {
+    auto* const io = connectionIoContext(request);
+    if (io == nullptr) {
+        response.end();
+        return;
     }
+    asio::post(*io, [&response] { response.end(); });
+}
 
+// The asynchronous part of every route: queues work on the executor, which builds the response on
+// a database thread, or answers 503 at once when the executor's queue is full. Runs on the crow
+// thread that received the request, crow keeps request and response alive until end().
+template<typename Work>
+void submitRoute(DbExecutor& executor, const std::shared_ptr<const RouteMetrics>& routeMetrics,
+                 const crow::request& request, crow::response& response, Work work) {
+    const auto received = metrics::Clock::now();
+    const bool queued = executor.Submit([routeMetrics, received, &request, &response, work = std::move(work)] {
+        response = work();
+        routeMetrics->Record(response.code, received);
+        endOnConnectionThread(request, response);
+    });
+    if (!queued) {
+        response = crow::response{crow::SERVICE_UNAVAILABLE, "too many requests in progress"};
+        routeMetrics->Record(response.code, received);
+        response.end();
+    }
 }
 
-// Annotation-style macro
+// Annotation-style macro. Handlers are asynchronous: the crow thread queues the request on the
+// DbExecutor and returns to its socket, a database thread builds the response and the connection's
+// I/O thread ends it, see submitRoute().
 #define REGISTER_ROUTE(Controller, Method, Path, HttpMethod) \
 struct Controller## _##Method##_RouteRegistrator { \
     Controller##_##Method##_RouteRegistrator() { \
         routeRegistry().push_back({ Path, HttpMethod, \
             [](crow::SimpleApp& app, const std::shared_ptr<Hypodermic::Container>& container) { \
+                    /* controllers are single instances, resolved once here instead of on every request */ \
+                    const std::shared_ptr<Controller> controller = container->resolve<Controller>(); \
+                    const std::shared_ptr<DbExecutor> executor = container->resolve<DbExecutor>(); \
+                    const size_t minCompressSize = container->resolve<config::RunConfiguration>()->minCompressSize; \
+                    const auto routeMetrics = std::make_shared<const RouteMetrics>(Path, HttpMethod); \
                     CROW_ROUTE(app, Path).methods(HttpMethod)( \
-                        [container](const crow::request& request ,auto&&... args) { \
-                        auto controller = container->resolve<Controller>(); \
-                        return invokeController(controller.get(), &Controller::Method, request, std::forward<decltype(args)>(args)...); \
+                        [controller, executor, minCompressSize, routeMetrics](const crow::request& request, crow::response& response, auto... args) { \
+                        submitRoute(*executor, routeMetrics, request, response, [controller, minCompressSize, &request, args...] { \
+                            return dispatchRoute(controller.get(), &Controller::Method, request, minCompressSize, args...); \
+                        }); \
                     } \
                 ); \
             } \
@@ -6,11 +6,17 @@ namespace config{
     struct RunConfiguration{
         int port;
         int concurrency;
+        // responses smaller than this are sent uncompressed even when the client accepts gzip/deflate
+        size_t minCompressSize = 1024;
+        // requests waiting for a database thread before new ones are turned away with 503
+        size_t maxQueuedRequests = 1024;
     };
 
     inline void from_json(const nlohmann::json& json, RunConfiguration& applicationProperties) {
         json.at("port").get_to(applicationProperties.port);
         json.at("concurrency").get_to(applicationProperties.concurrency);
+        applicationProperties.minCompressSize = json.value<size_t>("minCompressSize", 1024);
+        applicationProperties.maxQueuedRequests = json.value<size_t>("maxQueuedRequests", 1024);
     }
 }
 #endif
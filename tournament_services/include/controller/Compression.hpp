@@ -0,0 +1,161 @@
+#ifndef SERVICE_COMPRESSION_HPP
+#define SERVICE_COMPRESSION_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <crow.h>
+#include <zlib.h>
+
+#include "controller/ContentNegotiation.hpp"
+#include "metrics/Metrics.hpp"
+
+// gzip/deflate of response bodies, chosen from Accept-Encoding. Runs on the worker thread that
+// built the response, with a z_stream per thread and coding that is reset instead of reinitialized,
+// and an output buffer that swaps places with the body, so a response costs no allocation once the
+// buffers have grown to the usual response size.
+enum class ContentCoding { Identity, Gzip, Deflate };
+
+// Reported on /metrics.
+struct CompressionStats {
+    metrics::Counter responses;
+    metrics::Counter bytesIn;
+    metrics::Counter bytesOut;
+    metrics::Histogram duration;
+
+    static const CompressionStats& Instance() {
+        static const CompressionStats stats{
+            metrics::Registry::Instance().AddCounter("http_compressed_responses_total", "Responses sent with gzip or deflate."),
+            metrics::Registry::Instance().AddCounter("http_compression_input_bytes_total", "Body bytes before compression."),
+            metrics::Registry::Instance().AddCounter("http_compression_output_bytes_total", "Body bytes after compression."),
+            metrics::Registry::Instance().AddHistogram("http_compression_duration_seconds", "Worker time spent compressing a body.")
+        };
+        return stats;
+    }
+};
+
+// Coding preferred by an Accept-Encoding header, gzip on ties. Identity when the header is missing
+// or names nothing we produce.
+inline ContentCoding AcceptedCoding(std::string_view acceptEncoding) {
+    ContentCoding best = ContentCoding::Identity;
+    int bestWeight = 0;
+    while (!acceptEncoding.empty()) {
+        const size_t end = acceptEncoding.find(',');
+        const std::string_view entry = acceptEncoding.substr(0, end);
+        acceptEncoding = end == std::string_view::npos ? std::string_view{} : acceptEncoding.substr(end + 1);
+
+        const size_t parameters = entry.find(';');
+        const std::string_view coding = negotiation::Trim(entry.substr(0, parameters));
+        ContentCoding candidate;
+        if (negotiation::EqualsIgnoreCase(coding, "gzip") || negotiation::EqualsIgnoreCase(coding, "x-gzip") || coding == "*") {
+            candidate = ContentCoding::Gzip;
+        } else if (negotiation::EqualsIgnoreCase(coding, "deflate")) {
+            candidate = ContentCoding::Deflate;
+        } else {
+            continue;
+        }
+        const int weight = parameters == std::string_view::npos ? 1000 : negotiation::Weight(entry.substr(parameters + 1));
+        if (weight > bestWeight || (weight == bestWeight && weight > 0 && candidate == ContentCoding::Gzip)) {
+            best = candidate;
+            bestWeight = weight;
+        }
+    }
+    return best;
+}
+
+namespace compression {
+    class Deflater {
+        z_stream stream{};
+        bool ready = false;
+
+    public:
+        // 15 window bits is the zlib format HTTP calls "deflate", 16 more selects the gzip wrapper
+        explicit Deflater(const ContentCoding coding) {
+            const int windowBits = coding == ContentCoding::Gzip ? 15 + 16 : 15;
+            ready = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+        }
+
+        ~Deflater() {
+            if (ready) {
+                deflateEnd(&stream);
+            }
+        }
+
+        Deflater(const Deflater&) = delete;
+        Deflater& operator=(const Deflater&) = delete;
+
+        // Compresses input into out, which is resized to fit. False if zlib fails, out is then unspecified.
+        bool Compress(const std::string_view input, std::string& out) {
+            if (!ready || deflateReset(&stream) != Z_OK) {
+                return false;
+            }
+            out.resize(deflateBound(&stream, input.size()));
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+            stream.avail_in = static_cast<uInt>(input.size());
+            stream.next_out = reinterpret_cast<Bytef*>(out.data());
+            stream.avail_out = static_cast<uInt>(out.size());
+            if (deflate(&stream, Z_FINISH) != Z_STREAM_END) {
+                return false;
+            }
+            out.resize(stream.total_out);
+            return true;
+        }
+    };
+
+    inline Deflater& ThreadDeflater(const ContentCoding coding) {
+        thread_local Deflater gzip{ContentCoding::Gzip};
+        thread_local Deflater deflate{ContentCoding::Deflate};
+        return coding == ContentCoding::Gzip ? gzip : deflate;
+    }
+}
+
+// Compresses a successful response of at least minSize bytes when the request accepts gzip or deflate.
+//
+// The strong tag of a 2xx or 304 gets the accepted coding appended (see Conditional.hpp) whether or
+// not this body reaches minSize: a 304 has no body to measure, and it must repeat the tag of the 200
+// it stands for. The tag therefore names the negotiated coding, and the body of a given version,
+// format and coding is always the same bytes.
+inline void Compress(const crow::request& request, crow::response& response, const size_t minSize) {
+    const bool notModified = response.code == crow::NOT_MODIFIED;
+    if ((!notModified && (response.code < 200 || response.code >= 300))
+        || !response.get_header_value("content-encoding").empty()) {
+        return;
+    }
+    const ContentCoding coding = AcceptedCoding(request.get_header_value("accept-encoding"));
+    if (coding == ContentCoding::Identity) {
+        return;
+    }
+
+    bool varies = false;
+    if (std::string tag = response.get_header_value("etag"); tag.size() >= 2 && tag.back() == '"') {
+        tag.insert(tag.size() - 1, coding == ContentCoding::Gzip ? "-gzip" : "-deflate");
+        response.set_header("etag", tag);
+        response.add_header("vary", "accept-encoding");
+        varies = true;
+    }
+    if (notModified || response.body.size() < minSize) {
+        return;
+    }
+
+    thread_local std::string buffer;
+    const auto start = std::chrono::steady_clock::now();
+    if (!compression::ThreadDeflater(coding).Compress(response.body, buffer)) {
+        return;
+    }
+
+    const auto& stats = CompressionStats::Instance();
+    stats.duration.Observe(std::chrono::steady_clock::now() - start);
+    stats.responses.Add();
+    stats.bytesIn.Add(response.body.size());
+    stats.bytesOut.Add(buffer.size());
+
+    // the old body becomes next response's buffer
+    response.body.swap(buffer);
+    response.add_header("content-encoding", coding == ContentCoding::Gzip ? "gzip" : "deflate");
+    if (!varies) {
+        response.add_header("vary", "accept-encoding");
+    }
+}
+
+#endif //SERVICE_COMPRESSION_HPP
@@ -0,0 +1,115 @@
+#ifndef SERVICE_CONDITIONAL_HPP
+#define SERVICE_CONDITIONAL_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <crow.h>
+
+#include "controller/ContentNegotiation.hpp"
+#include "domain/Format.hpp"
+
+// Conditional requests on top of the repositories' row versions. A tag is "<id>.<version>-<format>":
+// strong, because JSON, CBOR and MessagePack bodies of the same row differ byte for byte. Compress()
+// appends the content coding ("...-json-gzip"), and comparisons drop that suffix again, so a tag
+// received with a compressed body still validates the resource.
+namespace conditional {
+    inline std::string_view FormatName(const domain::Format format) {
+        switch (format) {
+            case domain::Format::Cbor: return "cbor";
+            case domain::Format::MessagePack: return "msgpack";
+            case domain::Format::Json:
+            default: return "json";
+        }
+    }
+
+    // The tag without quotes and without a content coding suffix.
+    inline std::string_view Opaque(std::string_view tag) {
+        if (tag.size() < 2 || tag.front() != '"' || tag.back() != '"') {
+            return {};
+        }
+        tag = tag.substr(1, tag.size() - 2);
+        for (const std::string_view coding : {"-gzip", "-deflate"}) {
+            if (tag.ends_with(coding)) {
+                tag.remove_suffix(coding.size());
+                break;
+            }
+        }
+        return tag;
+    }
+
+    // Calls visit with every tag of an If-Match/If-None-Match list, weak ones keep their W/ prefix.
+    template<typename Visitor>
+    void ForEachTag(std::string_view header, Visitor visit) {
+        while (!header.empty()) {
+            const size_t end = header.find(',');
+            const std::string_view tag = negotiation::Trim(header.substr(0, end));
+            header = end == std::string_view::npos ? std::string_view{} : header.substr(end + 1);
+            if (!tag.empty()) {
+                visit(tag);
+            }
+        }
+    }
+}
+
+inline std::string EntityTag(const std::string_view id, const std::string_view version,
+                             const domain::Format format = CurrentResponseFormat()) {
+    const std::string_view formatName = conditional::FormatName(format);
+    std::string tag;
+    tag.reserve(id.size() + version.size() + formatName.size() + 4);
+    tag += '"';
+    tag += id;
+    tag += '.';
+    tag += version;
+    tag += '-';
+    tag += formatName;
+    tag += '"';
+    return tag;
+}
+
+// If-None-Match uses the weak comparison, so a W/ tag from a cache matches its strong original.
+inline bool NoneMatchHits(const crow::request& request, const std::string_view tag) {
+    bool hit = false;
+    conditional::ForEachTag(request.get_header_value("if-none-match"), [&](std::string_view candidate) {
+        if (candidate.starts_with("W/")) {
+            candidate.remove_prefix(2);
+        }
+        hit = hit || candidate == "*" || conditional::Opaque(candidate) == conditional::Opaque(tag);
+    });
+    return hit;
+}
+
+// 304 for a GET whose If-None-Match lists the current tag. No body, the tag and Vary are repeated.
+inline crow::response NotModified(const std::string& tag) {
+    crow::response response{crow::NOT_MODIFIED};
+    response.add_header("etag", tag);
+    response.add_header("vary", "accept");
+    return response;
+}
+
+// Versions of id named by the strong tags in If-Match, in any format. An empty result for a non
+// empty header means no tag can match and the request fails with 412.
+inline std::vector<std::string> IfMatchVersions(const std::string_view ifMatch, const std::string_view id) {
+    std::vector<std::string> versions;
+    conditional::ForEachTag(ifMatch, [&](const std::string_view candidate) {
+        std::string_view opaque = conditional::Opaque(candidate);
+        if (!opaque.starts_with(id) || opaque.size() <= id.size() || opaque[id.size()] != '.') {
+            return;
+        }
+        opaque.remove_prefix(id.size() + 1);
+        const std::string_view version = opaque.substr(0, opaque.find('-'));
+        if (!version.empty() && version.find_first_not_of("0123456789") == std::string_view::npos) {
+            versions.emplace_back(version);
+        }
+    });
+    return versions;
+}
+
+// True when the request carries an If-Match that has to be checked, "*" only asks for an existing
+// resource, which the unconditional update already requires.
+inline bool HasIfMatch(const crow::request& request) {
+    const std::string ifMatch = request.get_header_value("if-match");
+    return !negotiation::Trim(ifMatch).empty() && negotiation::Trim(ifMatch) != "*";
+}
+
+#endif //SERVICE_CONDITIONAL_HPP
@@ -0,0 +1,157 @@
+#ifndef SERVICE_CONTENT_NEGOTIATION_HPP
+#define SERVICE_CONTENT_NEGOTIATION_HPP
+
+#include <cctype>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <crow.h>
+#include <nlohmann/json.hpp>
+
+#include "domain/Encoding.hpp"
+#include "domain/Format.hpp"
+
+// Accept/Content-Type negotiation between JSON, CBOR and MessagePack. The route binder picks the
+// response format from the Accept header before calling the controller, the controllers encode
+// through Encoded()/ListEncoder and never look at the header themselves.
+namespace negotiation {
+    inline std::string_view Trim(std::string_view value) {
+        while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+        while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+        return value;
+    }
+
+    inline bool EqualsIgnoreCase(const std::string_view a, const std::string_view b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) return false;
+        }
+        return true;
+    }
+
+    // The format of a media type without parameters, JSON for anything else.
+    inline bool FormatOf(const std::string_view mediaType, domain::Format& format) {
+        if (EqualsIgnoreCase(mediaType, "application/cbor")) {
+            format = domain::Format::Cbor;
+        } else if (EqualsIgnoreCase(mediaType, "application/msgpack")
+                   || EqualsIgnoreCase(mediaType, "application/x-msgpack")
+                   || EqualsIgnoreCase(mediaType, "application/vnd.msgpack")) {
+            format = domain::Format::MessagePack;
+        } else if (EqualsIgnoreCase(mediaType, "application/json")
+                   || EqualsIgnoreCase(mediaType, "application/*")
+                   || EqualsIgnoreCase(mediaType, "*/*")) {
+            format = domain::Format::Json;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // q as thousandths, so "q=0.5" is 500. A malformed weight counts as 1.
+    inline int Weight(std::string_view parameters) {
+        while (!parameters.empty()) {
+            const size_t end = parameters.find(';');
+            const std::string_view parameter = Trim(parameters.substr(0, end));
+            parameters = end == std::string_view::npos ? std::string_view{} : parameters.substr(end + 1);
+            if (parameter.size() < 2 || (parameter[0] != 'q' && parameter[0] != 'Q') || parameter[1] != '=') {
+                continue;
+            }
+            double q = 1;
+            const std::string_view value = parameter.substr(2);
+            if (std::from_chars(value.data(), value.data() + value.size(), q).ec != std::errc{} || q > 1) {
+                return 1000;
+            }
+            return static_cast<int>(q * 1000);
+        }
+        return 1000;
+    }
+}
+
+// Format preferred by an Accept header. Ties go to the first listed, JSON when nothing we can
+// produce is acceptable (clients that ask for something odd get what they always got).
+inline domain::Format AcceptedFormat(std::string_view accept) {
+    domain::Format best = domain::Format::Json;
+    int bestWeight = 0;
+    while (!accept.empty()) {
+        const size_t end = accept.find(',');
+        const std::string_view range = accept.substr(0, end);
+        accept = end == std::string_view::npos ? std::string_view{} : accept.substr(end + 1);
+
+        const size_t parameters = range.find(';');
+        domain::Format format;
+        if (!negotiation::FormatOf(negotiation::Trim(range.substr(0, parameters)), format)) {
+            continue;
+        }
+        const int weight = parameters == std::string_view::npos ? 1000 : negotiation::Weight(range.substr(parameters + 1));
+        if (weight > bestWeight) {
+            best = format;
+            bestWeight = weight;
+        }
+    }
+    return best;
+}
+
+// Format of a request body. Bodies without a content-type, or with one we do not know, are read as JSON.
+inline domain::Format RequestFormat(const crow::request& request) {
+    const std::string& contentType = request.get_header_value("content-type");
+    const std::string_view mediaType = negotiation::Trim(std::string_view{contentType}.substr(0, contentType.find(';')));
+    domain::Format format = domain::Format::Json;
+    negotiation::FormatOf(mediaType, format);
+    return format;
+}
+
+inline domain::Format& CurrentResponseFormat() {
+    thread_local domain::Format format = domain::Format::Json;
+    return format;
+}
+
+// Sets the response format for the request handled on this thread, restores the previous one on exit.
+class ResponseFormatScope {
+    domain::Format previous;
+
+public:
+    explicit ResponseFormatScope(const domain::Format format) : previous(CurrentResponseFormat()) {
+        CurrentResponseFormat() = format;
+    }
+
+    ~ResponseFormatScope() { CurrentResponseFormat() = previous; }
+
+    ResponseFormatScope(const ResponseFormatScope&) = delete;
+    ResponseFormatScope& operator=(const ResponseFormatScope&) = delete;
+};
+
+// Content headers of a negotiated response. vary tells caches that the body depends on Accept.
+inline void AddContentHeaders(crow::response& response, const domain::Format format = CurrentResponseFormat()) {
+    response.add_header("content-type", std::string{domain::ContentType(format)});
+    response.add_header("vary", "accept");
+}
+
+// value in the format negotiated for the current request
+template<typename Type>
+crow::response Encoded(const Type& value, const int code = crow::OK) {
+    const domain::Format format = CurrentResponseFormat();
+    crow::response response{code, domain::Encode(format, value)};
+    AddContentHeaders(response, format);
+    return response;
+}
+
+// Ad hoc documents that have no domain type behind them go through nlohmann's own encoders.
+inline crow::response Encoded(const nlohmann::json& value, const int code = crow::OK) {
+    const domain::Format format = CurrentResponseFormat();
+    crow::response response{code};
+    switch (format) {
+        case domain::Format::Cbor:
+            nlohmann::json::to_cbor(value, nlohmann::detail::output_adapter<char>(response.body));
+            break;
+        case domain::Format::MessagePack:
+            nlohmann::json::to_msgpack(value, nlohmann::detail::output_adapter<char>(response.body));
+            break;
+        case domain::Format::Json:
+        default:
+            response.body = value.dump();
+    }
+    AddContentHeaders(response, format);
+    return response;
+}
+
+#endif //SERVICE_CONTENT_NEGOTIATION_HPP
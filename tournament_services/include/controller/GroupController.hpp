@@ -14,9 +14,12 @@ public:
     explicit GroupController(const std::shared_ptr<IGroupDelegate>& delegate);
     ~GroupController();
 
-    crow::response GetGroups(const std::string& tournamentId);
-    crow::response GetGroup(const std::string& tournamentId, const std::string& groupId);
+    // GET /tournaments/<id>/groups, or one page of it with ?limit=&after=
+    crow::response GetGroups(const crow::request& request, const std::string& tournamentId);
+    // answers 304 when If-None-Match names the group's current etag
+    crow::response GetGroup(const crow::request& request, const std::string& tournamentId, const std::string& groupId);
     crow::response CreateGroup(const crow::request& request, const std::string& tournamentId);
+    // with If-Match, 412 unless the group is still at one of the listed etags
     crow::response UpdateGroup(const crow::request& request, const std::string& tournamentId, const std::string& groupId);
     crow::response DeleteGroup(const std::string& tournamentId, const std::string& groupId);
     crow::response UpdateTeams(const crow::request& request, const std::string& tournamentId, const std::string& groupId);
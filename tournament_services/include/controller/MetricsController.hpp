@@ -0,0 +1,12 @@
+#ifndef TOURNAMENTS_METRICS_CONTROLLER_HPP
+#define TOURNAMENTS_METRICS_CONTROLLER_HPP
+
+#include <crow.h>
+
+// GET /metrics in the Prometheus text format.
+class MetricsController {
+public:
+    [[nodiscard]] crow::response GetMetrics() const;
+};
+
+#endif //TOURNAMENTS_METRICS_CONTROLLER_HPP
@@ -0,0 +1,51 @@
+#ifndef SERVICE_PAGINATION_HPP
+#define SERVICE_PAGINATION_HPP
+
+#include <charconv>
+#include <cstring>
+#include <expected>
+#include <format>
+#include <optional>
+#include <string>
+#include <crow.h>
+
+#include "controller/ContentNegotiation.hpp"
+#include "persistence/repository/Page.hpp"
+
+inline constexpr size_t MAX_PAGE_SIZE = 500;
+inline constexpr auto NEXT_CURSOR_HEADER = "x-next-cursor";
+
+// Reads ?limit=&after= from the query string. Returns no page when neither is present, so the
+// endpoint keeps returning the whole list, and an error message when they are malformed.
+inline std::expected<std::optional<PageRequest>, std::string> ParsePageRequest(const crow::request& request) {
+    const char* limit = request.url_params.get("limit");
+    const char* after = request.url_params.get("after");
+    if (limit == nullptr && after == nullptr) {
+        return std::nullopt;
+    }
+
+    PageRequest page;
+    if (limit != nullptr) {
+        const char* end = limit + std::strlen(limit);
+        const auto [last, error] = std::from_chars(limit, end, page.limit);
+        if (error != std::errc{} || last != end || page.limit == 0 || page.limit > MAX_PAGE_SIZE) {
+            return std::unexpected(std::format("limit must be between 1 and {}", MAX_PAGE_SIZE));
+        }
+    }
+    if (after != nullptr) {
+        page.after = after;
+    }
+    return page;
+}
+
+// Items as an array in the negotiated format, the cursor for the next page (if any) in the x-next-cursor header.
+template<typename Type>
+crow::response PageResponse(const Page<Type>& page) {
+    crow::response response = Encoded(page.items);
+    if (!page.nextCursor.empty()) {
+        response.add_header(NEXT_CURSOR_HEADER, page.nextCursor);
+    }
+    return response;
+}
+
+#endif //SERVICE_PAGINATION_HPP
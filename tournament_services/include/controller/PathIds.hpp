@@ -0,0 +1,16 @@
+#ifndef SERVICE_PATH_IDS_HPP
+#define SERVICE_PATH_IDS_HPP
+
+#include <string_view>
+
+#include "domain/Uuid.hpp"
+
+inline constexpr auto INVALID_ID_MESSAGE = "Invalid ID format";
+
+// Ids in a path are UUIDs, anything else is answered with 400 before reaching a delegate.
+template<typename... Ids>
+bool ValidIds(const Ids&... ids) {
+    return (domain::Uuid::Parse(std::string_view{ids}).has_value() && ...);
+}
+
+#endif //SERVICE_PATH_IDS_HPP
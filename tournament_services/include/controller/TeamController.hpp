@@ -9,20 +9,20 @@
 #include <crow.h>
 #include <nlohmann/json.hpp>
 #include <memory>
-#include <regex>
 
 #include "delegate/ITeamDelegate.hpp"
 
-static const std::regex ID_VALUE("[A-Za-z0-9\\-]+");
-
 class TeamController {
     std::shared_ptr<ITeamDelegate> teamDelegate;
 public:
     explicit TeamController(const std::shared_ptr<ITeamDelegate>& teamDelegate);
 
     [[nodiscard]] crow::response getTeam(const std::string& teamId) const;
-    [[nodiscard]] crow::response getAllTeams() const;
+    // GET /teams, or one page of it with ?limit=&after=
+    [[nodiscard]] crow::response getAllTeams(const crow::request& request) const;
     [[nodiscard]] crow::response SaveTeam(const crow::request& request) const;
+    // POST /teams/bulk, body is an array of teams. Answers one entry per team, in the same order.
+    [[nodiscard]] crow::response SaveTeams(const crow::request& request) const;
 
     [[nodiscard]] crow::response DeleteTeam(const std::string& teamId) const;
     [[nodiscard]] crow::response UpdateTeam(const crow::request& request, const std::string& teamId) const;
@@ -16,11 +16,17 @@ class TournamentController {
 public:
     explicit TournamentController(std::shared_ptr<ITournamentDelegate> tournament);
     [[nodiscard]] crow::response CreateTournament(const crow::request &request) const;
-    [[nodiscard]] crow::response ReadAll() const;
+    // GET /tournaments, or one page of it with ?limit=&after=. The full list carries an etag and
+    // answers 304 to a matching If-None-Match.
+    [[nodiscard]] crow::response ReadAll(const crow::request& request) const;
+
+    // GET /tournaments/<id>, with the etag to send in If-Match; 304 to a matching If-None-Match.
+    [[nodiscard]] crow::response GetTournament(const crow::request& request, const std::string& id) const;
 
     // Agregar en la clase TournamentController:
     [[nodiscard]] crow::response DeleteTournament(const std::string& id) const;
 
+    // 204 with the new etag; with If-Match, 412 unless the tournament is still at one of the listed etags
     [[nodiscard]] crow::response UpdateTournament(const crow::request& request, const std::string& id) const;
 };
 
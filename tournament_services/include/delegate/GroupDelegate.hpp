@@ -1,24 +1,42 @@
 #ifndef SERVICE_GROUP_DELEGATE_HPP
 #define SERVICE_GROUP_DELEGATE_HPP
 
+#include <algorithm>
+#include <format>
 #include <string>
 #include <string_view>
 #include <memory>
+#include <optional>
 #include <expected>
+#include <vector>
 
 #include "IGroupDelegate.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
 
 class GroupDelegate : public IGroupDelegate{
     std::shared_ptr<TournamentRepository> tournamentRepository;
     std::shared_ptr<IGroupRepository> groupRepository;
     std::shared_ptr<TeamRepository> teamRepository;
 
+    static std::vector<std::string> TeamIds(const std::vector<domain::Team>& teams) {
+        std::vector<std::string> ids;
+        ids.reserve(teams.size());
+        for (const auto& team : teams) {
+            ids.push_back(team.Id);
+        }
+        return ids;
+    }
+
 public:
     inline GroupDelegate(const std::shared_ptr<TournamentRepository>& tournamentRepository, const std::shared_ptr<IGroupRepository>& groupRepository, const std::shared_ptr<TeamRepository>& teamRepository);
     std::expected<std::string, std::string> CreateGroup(const std::string_view& tournamentId, const domain::Group& group) override;
     std::expected<std::vector<std::shared_ptr<domain::Group>>, std::string> GetGroups(const std::string_view& tournamentId) override;
+    std::expected<Page<domain::Group>, std::string> GetGroups(const std::string_view& tournamentId, const PageRequest& page) override;
     std::expected<std::shared_ptr<domain::Group>, std::string> GetGroup(const std::string_view& tournamentId, const std::string_view& groupId) override;
     std::expected<void, std::string> UpdateGroup(const std::string_view& tournamentId, const domain::Group& group) override;
+    std::expected<std::optional<std::string>, std::string> UpdateGroupIfVersion(const std::string_view& tournamentId, const domain::Group& group,
+                                                                                const std::vector<std::string>& versions) override;
+    std::string GetGroupVersion(const std::string_view& tournamentId, const std::string_view& groupId) override;
     std::expected<void, std::string> RemoveGroup(const std::string_view& tournamentId, const std::string_view& groupId) override;
     std::expected<void, std::string> UpdateTeams(const std::string_view& tournamentId, const std::string_view& groupId, const std::vector<domain::Team>& team) override;
 };
@@ -34,11 +52,9 @@ inline std::expected<std::string, std::string> GroupDelegate::CreateGroup(const
     domain::Group g = group;
     g.TournamentId() = tournament->Id();
     if (!g.Teams().empty()) {
-        for (auto& t : g.Teams()) {
-            auto team = teamRepository->ReadById(t.Id);
-            if (team == nullptr) {
-                return std::unexpected("Team doesn't exist");
-            }
+        const auto teamIds = TeamIds(g.Teams());
+        if (teamRepository->ReadByIds(teamIds).size() != teamIds.size()) {
+            return std::unexpected("Team doesn't exist");
         }
     }
     auto id = groupRepository->Create(g);
@@ -48,6 +64,19 @@ inline std::expected<std::string, std::string> GroupDelegate::CreateGroup(const
 inline std::expected<std::vector<std::shared_ptr<domain::Group>>, std::string> GroupDelegate::GetGroups(const std::string_view& tournamentId) {
     try {
         return this->groupRepository->FindByTournamentId(tournamentId);
+    } catch (const ConnectionPoolExhausted&) {
+        throw;
+    } catch (const std::exception& e) {
+        return std::unexpected("Error when reading to DB");
+    }
+}
+inline std::expected<Page<domain::Group>, std::string> GroupDelegate::GetGroups(const std::string_view& tournamentId, const PageRequest& page) {
+    try {
+        return this->groupRepository->FindByTournamentId(tournamentId, page);
+    } catch (const ConnectionPoolExhausted&) {
+        throw;
+    } catch (const std::invalid_argument&) {
+        throw;
     } catch (const std::exception& e) {
         return std::unexpected("Error when reading to DB");
     }
@@ -55,6 +84,8 @@ inline std::expected<std::vector<std::shared_ptr<domain::Group>>, std::string> G
 inline std::expected<std::shared_ptr<domain::Group>, std::string> GroupDelegate::GetGroup(const std::string_view& tournamentId, const std::string_view& groupId) {
     try {
         return groupRepository->FindByTournamentIdAndGroupId(tournamentId, groupId);
+    } catch (const ConnectionPoolExhausted&) {
+        throw;
     } catch (const std::exception& e) {
         return std::unexpected("Error when reading to DB");
     }
@@ -78,11 +109,30 @@ inline std::expected<void, std::string> GroupDelegate::UpdateGroup(const std::st
         // Actualizar el grupo
         groupRepository->Update(group);
         return {};
+    } catch (const ConnectionPoolExhausted&) {
+        throw;
     } catch (const std::exception& e) {
         return std::unexpected(std::string("Error updating group: ") + e.what());
     }
 }
 
+inline std::expected<std::optional<std::string>, std::string> GroupDelegate::UpdateGroupIfVersion(const std::string_view& tournamentId,
+                                                                                                  const domain::Group& group,
+                                                                                                  const std::vector<std::string>& versions) {
+    try {
+        // one statement checks the version and that the group belongs to the tournament
+        return groupRepository->UpdateIfVersion(group, versions);
+    } catch (const ConnectionPoolExhausted&) {
+        throw;
+    } catch (const std::exception& e) {
+        return std::unexpected(std::string("Error updating group: ") + e.what());
+    }
+}
+
+inline std::string GroupDelegate::GetGroupVersion(const std::string_view& tournamentId, const std::string_view& groupId) {
+    return groupRepository->GroupVersion(tournamentId, groupId);
+}
+
 inline std::expected<void, std::string> GroupDelegate::RemoveGroup(const std::string_view& tournamentId, const std::string_view& groupId) {
     try {
         // Verificar que el grupo existe
@@ -94,6 +144,8 @@ inline std::expected<void, std::string> GroupDelegate::RemoveGroup(const std::st
         // Eliminar el grupo
         groupRepository->Delete(std::string(groupId));
         return {};
+    } catch (const ConnectionPoolExhausted&) {
+        throw;
     } catch (const std::exception& e) {
         return std::unexpected(std::string("Error deleting group: ") + e.what());
     }
@@ -101,24 +153,20 @@ inline std::expected<void, std::string> GroupDelegate::RemoveGroup(const std::st
 
 
 std::expected<void, std::string> GroupDelegate::UpdateTeams(const std::string_view& tournamentId, const std::string_view& groupId, const std::vector<domain::Team>& teams) {
-    const auto group = groupRepository->FindByTournamentIdAndGroupId(tournamentId, groupId);
-    if (group == nullptr) {
-        return std::unexpected("Group doesn't exist");
-    }
-    if (group->Teams().size() + teams.size() >= 16) {
-        return std::unexpected("Group at max capacity");
-    }
-    for (const auto& team : teams) {
-        if (const auto groupTeams = groupRepository->FindByTournamentIdAndTeamId(tournamentId, team.Id)) {
-            return std::unexpected(std::format("Team {} already exist", team.Id));
-        }
-    }
-    for (const auto& team : teams) {
-        const auto persistedTeam = teamRepository->ReadById(team.Id);
-        if (persistedTeam == nullptr) {
-            return std::unexpected(std::format("Team {} doesn't exist", team.Id));
-        }
-        groupRepository->UpdateGroupAddTeam(groupId, persistedTeam);
+    // validation and insert happen in one statement, so nothing can change in between
+    switch (const auto added = groupRepository->AddTeams(tournamentId, groupId, TeamIds(teams)); added.status) {
+        case AddTeamsStatus::TournamentNotFound:
+            return std::unexpected("Tournament doesn't exist");
+        case AddTeamsStatus::GroupNotFound:
+            return std::unexpected("Group doesn't exist");
+        case AddTeamsStatus::TeamNotFound:
+            return std::unexpected(std::format("Team {} doesn't exist", added.teamId));
+        case AddTeamsStatus::TeamAlreadyAssigned:
+            return std::unexpected(std::format("Team {} already exists in tournament {}", added.teamId, tournamentId));
+        case AddTeamsStatus::GroupFull:
+            return std::unexpected("Group at max capacity");
+        case AddTeamsStatus::Added:
+            break;
     }
     return {};
 }
@@ -1,20 +1,29 @@
 #ifndef SERVICE_IGROUP_DELEGATE_HPP
 #define SERVICE_IGROUP_DELEGATE_HPP
 
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 #include <expected>
 
 #include "domain/Group.hpp"
+#include "persistence/repository/Page.hpp"
 
 class IGroupDelegate{
 public:
     virtual ~IGroupDelegate() = default;
     virtual std::expected<std::string, std::string> CreateGroup(const std::string_view& tournamentId, const domain::Group& group) = 0;
     virtual std::expected<std::vector<std::shared_ptr<domain::Group>>, std::string> GetGroups(const std::string_view& tournamentId) = 0;
+    virtual std::expected<Page<domain::Group>, std::string> GetGroups(const std::string_view& tournamentId, const PageRequest& page) = 0;
     virtual std::expected<std::shared_ptr<domain::Group>, std::string> GetGroup(const std::string_view& tournamentId, const std::string_view& groupId) = 0;
     virtual std::expected<void, std::string> UpdateGroup(const std::string_view& tournamentId, const domain::Group& group) = 0;
+    // UpdateGroup() applied only while the group is still at one of versions (If-Match). The value
+    // is the new version, nullopt when the group changed in between.
+    virtual std::expected<std::optional<std::string>, std::string> UpdateGroupIfVersion(const std::string_view& tournamentId, const domain::Group& group,
+                                                                                        const std::vector<std::string>& versions) = 0;
+    // Version of a group for conditional GETs, empty when the group is not in the tournament.
+    virtual std::string GetGroupVersion(const std::string_view& tournamentId, const std::string_view& groupId) = 0;
     virtual std::expected<void, std::string> RemoveGroup(const std::string_view& tournamentId, const std::string_view& groupId) = 0;
     virtual std::expected<void, std::string> UpdateTeams(const std::string_view& tournamentId, const std::string_view& groupId, const std::vector<domain::Team>& teams) = 0;
 };
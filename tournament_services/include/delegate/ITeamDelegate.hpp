@@ -1,20 +1,32 @@
 #ifndef ITEAM_DELEGATE_HPP
 #define ITEAM_DELEGATE_HPP
 
+#include <functional>
 #include <string_view>
 #include <memory>
 #include <expected>  // ← AGREGA ESTO
 
 #include "domain/Team.hpp"
+#include "persistence/repository/ITeamRepository.hpp"
+#include "persistence/repository/Page.hpp"
 
 class ITeamDelegate {
 public:
     virtual ~ITeamDelegate() = default;
     virtual std::shared_ptr<domain::Team> GetTeam(std::string_view id) = 0;
     virtual std::vector<std::shared_ptr<domain::Team>> GetAllTeams() = 0;
+    virtual Page<domain::Team> GetTeamsPage(const PageRequest& page) = 0;
+    // Same teams as GetAllTeams(), handed over one at a time instead of collected in a vector.
+    virtual void StreamAllTeams(const std::function<void(const domain::Team&)>& consumer) {
+        for (const auto& team : GetAllTeams()) {
+            consumer(*team);
+        }
+    }
     virtual void DeleteTeam(std::string_view id) = 0;
     virtual void UpdateTeam(std::string_view id, const domain::Team& team) = 0;
+    virtual bool TeamNameExists(std::string_view name) = 0;
     virtual std::string_view SaveTeam(const domain::Team& team) = 0;
+    virtual std::vector<TeamImportResult> SaveTeams(const std::vector<domain::Team>& teams) = 0;
 
     // virtual std::expected<std::string_view, std::string> SaveTeam(const domain::Team& team) = 0;
     // virtual std::expected<void, std::string> UpdateTeam(std::string_view id, const domain::Team& team) = 0;
@@ -5,20 +5,41 @@
 #ifndef TOURNAMENTS_ITOURNAMENTDELEGATE_HPP
 #define TOURNAMENTS_ITOURNAMENTDELEGATE_HPP
 
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "domain/Tournament.hpp"
+#include "persistence/repository/Page.hpp"
 
 class ITournamentDelegate {
 public:
     virtual ~ITournamentDelegate() = default;
 
     virtual std::string CreateTournament(std::shared_ptr<domain::Tournament> tournament) = 0;
+    // nullptr when there is no such tournament
+    virtual std::shared_ptr<domain::Tournament> ReadById(const std::string& id) = 0;
     virtual std::vector<std::shared_ptr<domain::Tournament>> ReadAll() = 0;
+    virtual Page<domain::Tournament> ReadPage(const PageRequest& page) = 0;
+    // Same tournaments as ReadAll(), handed over one at a time instead of collected in a vector.
+    virtual void StreamAll(const std::function<void(const domain::Tournament&)>& consumer) {
+        for (const auto& tournament : ReadAll()) {
+            consumer(*tournament);
+        }
+    }
 
-    virtual void UpdateTournament(const std::string& id, std::shared_ptr<domain::Tournament> tournament) = 0;
+    // Returns the tournament's new version, empty when it is not tracked.
+    virtual std::string UpdateTournament(const std::string& id, std::shared_ptr<domain::Tournament> tournament) = 0;
+    // UpdateTournament() applied only while the tournament is still at one of versions (If-Match).
+    // Returns the new version, nullopt when the tournament changed in between.
+    virtual std::optional<std::string> UpdateTournamentIfVersion(const std::string& id, std::shared_ptr<domain::Tournament> tournament,
+                                                                 const std::vector<std::string>& versions) = 0;
+    // Version of one tournament for conditional requests, empty when there is no such tournament.
+    virtual std::string TournamentVersion(const std::string& id) = 0;
+    // Version of the whole collection for conditional GETs, empty when it is not tracked.
+    virtual std::string CollectionVersion() = 0;
     virtual void DeleteTournament(const std::string& id) = 0;
 };
 
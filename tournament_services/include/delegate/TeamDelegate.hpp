@@ -6,7 +6,7 @@
 #define RESTAPI_TESTDELEGATE_HPP
 #include <memory>
 
-#include "persistence/repository/IRepository.hpp"
+#include "persistence/repository/ITeamRepository.hpp"
 #include "domain/Team.hpp"
 
 #include <expected>  // ← AGREGA ESTO
@@ -14,12 +14,16 @@
 #include "ITeamDelegate.hpp"
 
 class TeamDelegate : public ITeamDelegate {
-    std::shared_ptr<IRepository<domain::Team, std::string_view>> teamRepository;
+    std::shared_ptr<ITeamRepository> teamRepository;
 public:
-    explicit TeamDelegate(std::shared_ptr<IRepository<domain::Team, std::string_view>> repository);
+    explicit TeamDelegate(std::shared_ptr<ITeamRepository> repository);
     std::shared_ptr<domain::Team> GetTeam(std::string_view id) override;
     std::vector<std::shared_ptr<domain::Team>> GetAllTeams() override;
+    Page<domain::Team> GetTeamsPage(const PageRequest& page) override;
+    void StreamAllTeams(const std::function<void(const domain::Team&)>& consumer) override;
+    bool TeamNameExists(std::string_view name) override;
     std::string_view SaveTeam( const domain::Team& team) override;
+    std::vector<TeamImportResult> SaveTeams(const std::vector<domain::Team>& teams) override;
     void DeleteTeam(std::string_view id) override;
     void UpdateTeam(std::string_view id, const domain::Team& team) override;
 };
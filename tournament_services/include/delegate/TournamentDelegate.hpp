@@ -6,26 +6,31 @@
 #define TOURNAMENTS_TOURNAMENTDELEGATE_HPP
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
-#include "cms/QueueMessageProducer.hpp"
 #include "delegate/ITournamentDelegate.hpp"
 #include "persistence/repository/IRepository.hpp"
 #include "domain/Tournament.hpp"
 
 class TournamentDelegate : public ITournamentDelegate {
     std::shared_ptr<IRepository<domain::Tournament, std::string>> tournamentRepository;
-    std::shared_ptr<QueueMessageProducer> producer;
 
 public:
-    explicit TournamentDelegate(std::shared_ptr<IRepository<domain::Tournament, std::string>> repository,
-                                std::shared_ptr<QueueMessageProducer> producer);
+    explicit TournamentDelegate(std::shared_ptr<IRepository<domain::Tournament, std::string>> repository);
 
     std::string CreateTournament(std::shared_ptr<domain::Tournament> tournament) override;
+    std::shared_ptr<domain::Tournament> ReadById(const std::string& id) override;
     std::vector<std::shared_ptr<domain::Tournament>> ReadAll() override;
-
-    void UpdateTournament(const std::string& id, std::shared_ptr<domain::Tournament> tournament) override;
+    Page<domain::Tournament> ReadPage(const PageRequest& page) override;
+    void StreamAll(const std::function<void(const domain::Tournament&)>& consumer) override;
+
+    std::string UpdateTournament(const std::string& id, std::shared_ptr<domain::Tournament> tournament) override;
+    std::optional<std::string> UpdateTournamentIfVersion(const std::string& id, std::shared_ptr<domain::Tournament> tournament,
+                                                         const std::vector<std::string>& versions) override;
+    std::string TournamentVersion(const std::string& id) override;
+    std::string CollectionVersion() override;
     void DeleteTournament(const std::string& id) override;
 };
 
@@ -13,18 +13,35 @@
 
 int main() {
     activemq::library::ActiveMQCPP::initializeLibrary();
-    const auto container = config::containerSetup();
-    crow::SimpleApp app;
+    {
+        // the relay, the producers and the connection manager go with the container, before the
+        // library is shut down
+        const auto container = config::containerSetup();
+        crow::SimpleApp app;
 
-    // Bind all annotated routes
-    for (auto& def : routeRegistry()) {
-        def.binder(app, container);
-    }
+        // start serving as soon as the minimum number of connections is live, the rest keep opening in background
+        container->resolve<PostgresConnectionProvider>()->WaitUntilReady();
+        CROW_LOG_INFO << "database pool ready";
+        // publishes what is left in the outbox and keeps relaying while the service runs
+        const auto outboxRelay = container->resolve<OutboxRelay>();
+        outboxRelay->Start();
+
+        // Bind all annotated routes
+        for (auto& def : routeRegistry()) {
+            def.binder(app, container);
+        }
 
-    auto appConfig = container->resolve<config::RunConfiguration>();
+        auto appConfig = container->resolve<config::RunConfiguration>();
+        const auto executor = container->resolve<DbExecutor>();
 
-    app.port(appConfig->port)
-        .concurrency(appConfig->concurrency)
-        .run();
+        app.port(appConfig->port)
+            .concurrency(appConfig->concurrency)
+            .run();
+
+        // run() returns with the I/O contexts stopped but the app and its connections still alive.
+        // Requests queued or running on the executor hold their connection's request and response,
+        // so they finish here, before the app is destroyed.
+        executor->Shutdown();
+    }
     activemq::library::ActiveMQCPP::shutdownLibrary();
 }
@@ -1,6 +1,13 @@
 #include "controller/GroupController.hpp"
+#include "controller/Conditional.hpp"
+#include "controller/ContentNegotiation.hpp"
+#include "controller/Pagination.hpp"
+#include "controller/PathIds.hpp"
 #include "configuration/RouteDefinition.hpp"
+#include "domain/JsonDecoder.hpp"
+#include "domain/JsonWriter.hpp"
 #include "domain/Utilities.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
 #include <nlohmann/json.hpp>
 
 #define JSON_CONTENT_TYPE "application/json"
@@ -11,23 +18,49 @@ GroupController::GroupController(const std::shared_ptr<IGroupDelegate>& delegate
 
 GroupController::~GroupController() {}
 
-crow::response GroupController::GetGroups(const std::string& tournamentId) {
+crow::response GroupController::GetGroups(const crow::request& request, const std::string& tournamentId) {
+    if (!ValidIds(tournamentId)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
+    }
+    const auto page = ParsePageRequest(request);
+    if (!page) {
+        return crow::response{crow::BAD_REQUEST, page.error()};
+    }
+    if (page->has_value()) {
+        try {
+            if (auto groups = this->groupDelegate->GetGroups(tournamentId, **page)) {
+                return PageResponse(*groups);
+            }
+        } catch (const std::invalid_argument& e) {
+            return crow::response{crow::BAD_REQUEST, e.what()};
+        }
+        return crow::response{crow::INTERNAL_SERVER_ERROR};
+    }
+
     if (auto groups = this->groupDelegate->GetGroups(tournamentId)) {
-        const nlohmann::json body = *groups;
-        crow::response response{crow::OK, body.dump()};
-        response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
-        return response;
+        return Encoded(*groups);
     }
     // Si falla, asumimos error del dominio (no se pidió diferenciar más en tests)
     return crow::response{crow::INTERNAL_SERVER_ERROR};
 }
 
-crow::response GroupController::GetGroup(const std::string& tournamentId, const std::string& groupId) {
+crow::response GroupController::GetGroup(const crow::request& request, const std::string& tournamentId, const std::string& groupId) {
+    if (!ValidIds(tournamentId, groupId)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
+    }
+    // a version-only query answers polls for an unchanged group, the document is never read
+    const std::string version = groupDelegate->GetGroupVersion(tournamentId, groupId);
+    const std::string tag = version.empty() ? std::string{} : EntityTag(groupId, version);
+    if (!tag.empty() && NoneMatchHits(request, tag)) {
+        return NotModified(tag);
+    }
+
     auto r = this->groupDelegate->GetGroup(tournamentId, groupId);
     if (r.has_value()) {
-        const nlohmann::json body = r.value();
-        crow::response response{crow::OK, body.dump()};
-        response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+        crow::response response = Encoded(r.value());
+        if (!tag.empty()) {
+            response.add_header("etag", tag);
+        }
         return response;
     }
     // Los tests esperan 404 cuando el delegate regresa unexpected(...)
@@ -35,14 +68,15 @@ crow::response GroupController::GetGroup(const std::string& tournamentId, const
 }
 
 crow::response GroupController::CreateGroup(const crow::request& request, const std::string& tournamentId) {
-    if (!nlohmann::json::accept(request.body)) {
-        return crow::response{crow::BAD_REQUEST, "Invalid JSON"};
+    if (!ValidIds(tournamentId)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
+    }
+    auto group = domain::DecodeGroup(request.body, RequestFormat(request));
+    if (!group) {
+        return crow::response{crow::BAD_REQUEST, group.error().Describe()};
     }
 
-    auto requestBody = nlohmann::json::parse(request.body);
-    domain::Group group = requestBody;
-
-    auto groupId = groupDelegate->CreateGroup(tournamentId, group);
+    auto groupId = groupDelegate->CreateGroup(tournamentId, *group);
     crow::response response;
     if (groupId) {
         response.add_header("location", *groupId);
@@ -58,18 +92,38 @@ crow::response GroupController::CreateGroup(const crow::request& request, const
 crow::response GroupController::UpdateGroup(const crow::request& request,
                                             const std::string& tournamentId,
                                             const std::string& groupId) {
-    if(!nlohmann::json::accept(request.body)) {
-        return crow::response{crow::BAD_REQUEST, "Invalid JSON"};
+    if (!ValidIds(tournamentId, groupId)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
+    }
+    auto decoded = domain::DecodeGroup(request.body, RequestFormat(request));
+    if (!decoded) {
+        return crow::response{crow::BAD_REQUEST, decoded.error().Describe()};
     }
 
     try {
-        auto requestBody = nlohmann::json::parse(request.body);
-        domain::Group group = requestBody;
+        domain::Group group = std::move(*decoded);
 
         // Asignar IDs del path
         group.Id() = groupId;
         group.TournamentId() = tournamentId;
 
+        if (HasIfMatch(request)) {
+            const auto versions = IfMatchVersions(request.get_header_value("if-match"), groupId);
+            if (versions.empty()) {
+                return crow::response{crow::PRECONDITION_FAILED, "group was modified since the given etag"};
+            }
+            const auto updated = groupDelegate->UpdateGroupIfVersion(tournamentId, group, versions);
+            if (!updated) {
+                return crow::response{crow::NOT_FOUND, updated.error()};
+            }
+            if (!updated->has_value()) {
+                return crow::response{crow::PRECONDITION_FAILED, "group was modified since the given etag"};
+            }
+            crow::response response{crow::NO_CONTENT};
+            response.add_header("etag", EntityTag(groupId, **updated));
+            return response;
+        }
+
         auto result = groupDelegate->UpdateGroup(tournamentId, group);
         if (result) {
             // Los tests esperan 204 en éxito
@@ -78,12 +132,17 @@ crow::response GroupController::UpdateGroup(const crow::request& request,
             // Y 404 cuando el delegate indica "Group doesn't exist"
             return crow::response{crow::NOT_FOUND, result.error()};
         }
+    } catch (const ConnectionPoolExhausted& e) {
+        return crow::response{crow::SERVICE_UNAVAILABLE, e.what()};
     } catch (const std::exception& e) {
         return crow::response{crow::INTERNAL_SERVER_ERROR, e.what()};
     }
 }
 
 crow::response GroupController::DeleteGroup(const std::string& tournamentId, const std::string& groupId) {
+    if (!ValidIds(tournamentId, groupId)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
+    }
     try {
         auto result = groupDelegate->RemoveGroup(tournamentId, groupId);
         if (result) {
@@ -91,6 +150,8 @@ crow::response GroupController::DeleteGroup(const std::string& tournamentId, con
         } else {
             return crow::response{crow::NOT_FOUND, result.error()};
         }
+    } catch (const ConnectionPoolExhausted& e) {
+        return crow::response{crow::SERVICE_UNAVAILABLE, e.what()};
     } catch (const std::exception& e) {
         return crow::response{crow::INTERNAL_SERVER_ERROR, e.what()};
     }
@@ -99,12 +160,15 @@ crow::response GroupController::DeleteGroup(const std::string& tournamentId, con
 crow::response GroupController::UpdateTeams(const crow::request& request,
                                             const std::string& tournamentId,
                                             const std::string& groupId) {
-    if (!nlohmann::json::accept(request.body)) {
-        return crow::response{crow::BAD_REQUEST, "Invalid JSON"};
+    if (!ValidIds(tournamentId, groupId)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
+    }
+    const auto teams = domain::DecodeTeams(request.body, false, RequestFormat(request));
+    if (!teams) {
+        return crow::response{crow::BAD_REQUEST, teams.error().Describe()};
     }
 
-    const std::vector<domain::Team> teams = nlohmann::json::parse(request.body);
-    const auto result = groupDelegate->UpdateTeams(tournamentId, groupId, teams);
+    const auto result = groupDelegate->UpdateTeams(tournamentId, groupId, *teams);
     if (result) {
         return crow::response{crow::NO_CONTENT};
     }
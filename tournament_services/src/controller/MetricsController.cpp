@@ -0,0 +1,28 @@
+#include "configuration/RouteDefinition.hpp"
+#include "controller/Compression.hpp"
+#include "controller/MetricsController.hpp"
+#include "metrics/Metrics.hpp"
+
+#include <format>
+#include <string>
+
+crow::response MetricsController::GetMetrics() const {
+    // registers the compression series, so they are listed before the first compressed response
+    const auto& compression = CompressionStats::Instance();
+    auto& registry = metrics::Registry::Instance();
+
+    std::string body;
+    registry.Write(body);
+
+    const uint64_t bytesIn = registry.Total(compression.bytesIn);
+    const uint64_t bytesOut = registry.Total(compression.bytesOut);
+    body += "# HELP http_compression_ratio Input bytes per output byte since start.\n"
+            "# TYPE http_compression_ratio gauge\n";
+    body += std::format("http_compression_ratio {:.3f}\n", bytesOut == 0 ? 0.0 : static_cast<double>(bytesIn) / static_cast<double>(bytesOut));
+
+    crow::response response{crow::OK, std::move(body)};
+    response.add_header("content-type", "text/plain; version=0.0.4");
+    return response;
+}
+
+REGISTER_ROUTE(MetricsController, GetMetrics, "/metrics", "GET"_method)
@@ -7,11 +7,17 @@
 
 #include "configuration/RouteDefinition.hpp"
 #include "controller/TeamController.hpp"
+#include "controller/ContentNegotiation.hpp"
+#include "controller/Pagination.hpp"
+#include "controller/PathIds.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
+#include "domain/JsonDecoder.hpp"
+#include "domain/JsonWriter.hpp"
 #include "domain/Utilities.hpp"
 
-#include <regex>
 #include <string>
 #include <string_view>
+#include <vector>
 
 static bool is_conflict_message(const std::string& msg) {
     // Heurística simple para mapear errores de constraint/duplicado a 409
@@ -27,38 +33,52 @@ TeamController::TeamController(const std::shared_ptr<ITeamDelegate>& teamDelegat
     : teamDelegate(teamDelegate) {}
 
 crow::response TeamController::getTeam(const std::string& teamId) const {
-    if(!std::regex_match(teamId, ID_VALUE)) {
-        return crow::response{crow::BAD_REQUEST, "Invalid ID format"};
+    if(!ValidIds(teamId)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
     }
 
     if(auto team = teamDelegate->GetTeam(teamId); team != nullptr) {
-        nlohmann::json body = team;
-        auto response = crow::response{crow::OK, body.dump()};
-        response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
-        return response;
+        return Encoded(team);
     }
     return crow::response{crow::NOT_FOUND, "team not found"};
 }
 
-crow::response TeamController::getAllTeams() const {
-    nlohmann::json body = teamDelegate->GetAllTeams();
-    crow::response response{crow::OK, body.dump()};
-    response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+crow::response TeamController::getAllTeams(const crow::request& request) const {
+    const auto page = ParsePageRequest(request);
+    if (!page) {
+        return crow::response{crow::BAD_REQUEST, page.error()};
+    }
+    if (page->has_value()) {
+        try {
+            return PageResponse(teamDelegate->GetTeamsPage(**page));
+        } catch (const std::invalid_argument& e) {
+            return crow::response{crow::BAD_REQUEST, e.what()};
+        }
+    }
+
+    // rows are serialized into the body as they arrive, no intermediate vector or json array. Crow
+    // sends the body only once the handler returns, so it is still held whole; ?limit= bounds it.
+    crow::response response{crow::OK};
+    domain::ListEncoder list{response.body, CurrentResponseFormat()};
+    teamDelegate->StreamAllTeams([&list](const domain::Team& team) {
+        list.Add(team);
+    });
+    list.Close();
+    AddContentHeaders(response);
     return response;
 }
 
 crow::response TeamController::UpdateTeam(const crow::request& request, const std::string& teamId) const {
-    if(!std::regex_match(teamId, ID_VALUE)) {
-        return crow::response{crow::BAD_REQUEST, "Invalid ID format"};
+    if(!ValidIds(teamId)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
     }
 
     try {
-        if(!nlohmann::json::accept(request.body)) {
-            return crow::response{crow::BAD_REQUEST, "Invalid JSON"};
+        auto decoded = domain::DecodeTeam(request.body, RequestFormat(request));
+        if (!decoded) {
+            return crow::response{crow::BAD_REQUEST, decoded.error().Describe()};
         }
-
-        auto requestBody = nlohmann::json::parse(request.body);
-        domain::Team team = requestBody;
+        domain::Team team = std::move(*decoded);
 
         // ← IMPORTANTE: Asignar el id de la URL
         team.Id = teamId;
@@ -67,6 +87,8 @@ crow::response TeamController::UpdateTeam(const crow::request& request, const st
 
         // Los tests esperan 204 en actualización exitosa
         return crow::response{crow::NO_CONTENT};
+    } catch (const ConnectionPoolExhausted& e) {
+        return crow::response{crow::SERVICE_UNAVAILABLE, e.what()};
     } catch (const std::runtime_error& e) {
         return crow::response{crow::NOT_FOUND, e.what()};
     } catch (const std::exception& e) {
@@ -75,37 +97,30 @@ crow::response TeamController::UpdateTeam(const crow::request& request, const st
 }
 
 crow::response TeamController::SaveTeam(const crow::request& request) const {
-    // Validar formato JSON
-    if (!nlohmann::json::accept(request.body)) {
-        return crow::response{crow::BAD_REQUEST};
-    }
-
-    auto body = nlohmann::json::parse(request.body);
-    if (!body.contains("name") || !body["name"].is_string()) {
-        return crow::response{crow::BAD_REQUEST};
+    // Validar formato JSON y que exista "name", en una sola pasada
+    auto decoded = domain::DecodeTeam(request.body, RequestFormat(request));
+    if (!decoded) {
+        return crow::response{crow::BAD_REQUEST, decoded.error().Describe()};
     }
+    const domain::Team team = std::move(*decoded);
 
-    domain::Team team = body;
-
-    // Validar duplicados (por nombre)
-    auto existing = teamDelegate->GetAllTeams();
-    for (auto& t : existing) {
-        if (t->Name == team.Name) {
+    try {
+        // Validar duplicados (por nombre). Es solo una consulta al indice unico; si otra peticion
+        // inserta el mismo nombre entre la consulta y el insert, la restriccion unica responde 409 abajo.
+        if (teamDelegate->TeamNameExists(team.Name)) {
             crow::response conflict{crow::CONFLICT};
             conflict.body = R"({"error":"Team already exists"})";
             conflict.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
             return conflict;
         }
-    }
 
-    try {
         auto newId = teamDelegate->SaveTeam(team);
 
-        nlohmann::json respJson = {{"id", newId}, {"name", team.Name}};
-        crow::response response{crow::CREATED, respJson.dump()};
+        crow::response response = Encoded(domain::Team{std::string{newId}, team.Name}, crow::CREATED);
         response.add_header("location", std::string{newId});
-        response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
         return response;
+    } catch (const ConnectionPoolExhausted& e) {
+        return crow::response{crow::SERVICE_UNAVAILABLE, e.what()};
     } catch (const std::runtime_error& e) {
         // Mapear constraint/duplicado a 409; otros errores a 500
         if (is_conflict_message(e.what())) {
@@ -117,14 +132,42 @@ crow::response TeamController::SaveTeam(const crow::request& request) const {
     }
 }
 
+crow::response TeamController::SaveTeams(const crow::request& request) const {
+    auto decoded = domain::DecodeTeams(request.body, true, RequestFormat(request));
+    if (!decoded) {
+        return crow::response{crow::BAD_REQUEST, decoded.error().Describe()};
+    }
+    const std::vector<domain::Team> teams = std::move(*decoded);
+
+    try {
+        const auto created = teamDelegate->SaveTeams(teams);
+
+        nlohmann::json respJson = nlohmann::json::array();
+        for (size_t i = 0; i < teams.size(); i++) {
+            if (created[i].duplicate) {
+                respJson.push_back({{"name", teams[i].Name}, {"error", "Team already exists"}});
+            } else {
+                respJson.push_back({{"id", created[i].id}, {"name", teams[i].Name}});
+            }
+        }
+        return Encoded(respJson);
+    } catch (const ConnectionPoolExhausted& e) {
+        return crow::response{crow::SERVICE_UNAVAILABLE, e.what()};
+    } catch (const std::exception& e) {
+        return crow::response{crow::INTERNAL_SERVER_ERROR, std::string{"error creating teams: "} + e.what()};
+    }
+}
+
 crow::response TeamController::DeleteTeam(const std::string& teamId) const {
-    if(!std::regex_match(teamId, ID_VALUE)) {
-        return crow::response{crow::BAD_REQUEST, "Invalid ID format"};
+    if(!ValidIds(teamId)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
     }
 
     try {
         teamDelegate->DeleteTeam(teamId);
         return crow::response{crow::NO_CONTENT};
+    } catch (const ConnectionPoolExhausted& e) {
+        return crow::response{crow::SERVICE_UNAVAILABLE, e.what()};
     } catch (const std::runtime_error& e) {
         std::string msg = e.what();
         if (msg.find("not found") != std::string::npos)
@@ -137,5 +180,6 @@ crow::response TeamController::DeleteTeam(const std::string& teamId) const {
 REGISTER_ROUTE(TeamController, getTeam, "/teams/<string>", "GET"_method)
 REGISTER_ROUTE(TeamController, getAllTeams, "/teams", "GET"_method)
 REGISTER_ROUTE(TeamController, SaveTeam, "/teams", "POST"_method)
+REGISTER_ROUTE(TeamController, SaveTeams, "/teams/bulk", "POST"_method)
 REGISTER_ROUTE(TeamController, DeleteTeam, "/teams/<string>", "DELETE"_method)
 REGISTER_ROUTE(TeamController, UpdateTeam, "/teams/<string>", "PUT"_method)
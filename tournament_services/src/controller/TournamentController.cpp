@@ -2,14 +2,19 @@
 // Created by tsuny on 8/31/25.
 //
 
-#define JSON_CONTENT_TYPE "application/json"
-#define CONTENT_TYPE_HEADER "content-type"
-
 #include "configuration/RouteDefinition.hpp"
 #include "controller/TournamentController.hpp"
+#include "controller/Conditional.hpp"
+#include "controller/ContentNegotiation.hpp"
+#include "controller/Pagination.hpp"
+#include "controller/PathIds.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
 
+#include <optional>
 #include <string>
 #include <utility>
+#include "domain/JsonDecoder.hpp"
+#include "domain/JsonWriter.hpp"
 #include "domain/Tournament.hpp"
 #include "domain/Utilities.hpp"
 #include <nlohmann/json.hpp>
@@ -20,13 +25,12 @@ TournamentController::TournamentController(std::shared_ptr<ITournamentDelegate>
 
 crow::response TournamentController::CreateTournament(const crow::request &request) const {
     try {
-        if (!nlohmann::json::accept(request.body)) {
-            return crow::response{crow::BAD_REQUEST, "Invalid JSON"};
+        auto decoded = domain::DecodeTournament(request.body, RequestFormat(request));
+        if (!decoded) {
+            return crow::response{crow::BAD_REQUEST, decoded.error().Describe()};
         }
-
-        nlohmann::json body = nlohmann::json::parse(request.body);
         const std::shared_ptr<domain::Tournament> tournament =
-            std::make_shared<domain::Tournament>(body);
+            std::make_shared<domain::Tournament>(std::move(*decoded));
 
         const std::string id = tournamentDelegate->CreateTournament(tournament);
         if (id.empty()) {
@@ -39,26 +43,90 @@ crow::response TournamentController::CreateTournament(const crow::request &reque
         response.add_header("location", id);
         return response;
 
+    } catch (const ConnectionPoolExhausted& e) {
+        return crow::response{crow::SERVICE_UNAVAILABLE, e.what()};
     } catch (const std::exception&) {
         // El test de conflicto simula un throw (duplicado) desde el delegate
         return crow::response{crow::CONFLICT};
     }
 }
 
-crow::response TournamentController::ReadAll() const {
-    nlohmann::json body = tournamentDelegate->ReadAll();
+crow::response TournamentController::ReadAll(const crow::request& request) const {
+    const auto page = ParsePageRequest(request);
+    if (!page) {
+        return crow::response{crow::BAD_REQUEST, page.error()};
+    }
+    if (page->has_value()) {
+        try {
+            return PageResponse(tournamentDelegate->ReadPage(**page));
+        } catch (const std::invalid_argument& e) {
+            return crow::response{crow::BAD_REQUEST, e.what()};
+        }
+    }
+
+    // The version is read before the rows: a tournament changed in between gives a body newer than
+    // its tag, and the next poll simply downloads it again.
+    const std::string version = tournamentDelegate->CollectionVersion();
+    const std::string tag = version.empty() ? std::string{} : EntityTag("tournaments", version);
+    if (!tag.empty() && NoneMatchHits(request, tag)) {
+        return NotModified(tag);
+    }
+
+    // rows are serialized into the body as they arrive, no intermediate vector or json array. Crow
+    // sends the body only once the handler returns, so it is still held whole; ?limit= bounds it.
     crow::response response;
     response.code = crow::OK;
-    response.body = body.dump();
-    response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+    domain::ListEncoder list{response.body, CurrentResponseFormat()};
+    tournamentDelegate->StreamAll([&list](const domain::Tournament& tournament) {
+        list.Add(tournament);
+    });
+    list.Close();
+    AddContentHeaders(response);
+    if (!tag.empty()) {
+        response.add_header("etag", tag);
+    }
     return response;
 }
 
+// GET /tournaments/<id>
+crow::response TournamentController::GetTournament(const crow::request& request, const std::string& id) const {
+    if (!ValidIds(id)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
+    }
+    try {
+        // a version-only query answers polls for an unchanged tournament, the document is never read
+        const std::string version = tournamentDelegate->TournamentVersion(id);
+        const std::string tag = version.empty() ? std::string{} : EntityTag(id, version);
+        if (!tag.empty() && NoneMatchHits(request, tag)) {
+            return NotModified(tag);
+        }
+
+        const auto tournament = tournamentDelegate->ReadById(id);
+        if (!tournament) {
+            return crow::response{crow::NOT_FOUND, "Tournament not found"};
+        }
+        crow::response response = Encoded(*tournament);
+        if (!tag.empty()) {
+            response.add_header("etag", tag);
+        }
+        return response;
+    } catch (const ConnectionPoolExhausted& e) {
+        return crow::response{crow::SERVICE_UNAVAILABLE, e.what()};
+    } catch (const std::exception& e) {
+        return crow::response{crow::INTERNAL_SERVER_ERROR, e.what()};
+    }
+}
+
 // DELETE /tournaments/<id>
 crow::response TournamentController::DeleteTournament(const std::string& id) const {
+    if (!ValidIds(id)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
+    }
     try {
         tournamentDelegate->DeleteTournament(id);
         return crow::response{crow::NO_CONTENT};
+    } catch (const ConnectionPoolExhausted& e) {
+        return crow::response{crow::SERVICE_UNAVAILABLE, e.what()};
     } catch (const std::runtime_error& e) {
         return crow::response{crow::NOT_FOUND, e.what()};
     } catch (const std::exception& e) {
@@ -68,24 +136,39 @@ crow::response TournamentController::DeleteTournament(const std::string& id) con
 
 // PUT /tournaments/<id>
 crow::response TournamentController::UpdateTournament(const crow::request& request, const std::string& id) const {
+    if (!ValidIds(id)) {
+        return crow::response{crow::BAD_REQUEST, INVALID_ID_MESSAGE};
+    }
     try {
-        if (!nlohmann::json::accept(request.body)) {
-            return crow::response{crow::BAD_REQUEST, "Invalid JSON"};
+        auto decoded = domain::DecodeTournament(request.body, RequestFormat(request));
+        if (!decoded) {
+            return crow::response{crow::BAD_REQUEST, decoded.error().Describe()};
         }
-
-        nlohmann::json body = nlohmann::json::parse(request.body);
         const std::shared_ptr<domain::Tournament> tournament =
-            std::make_shared<domain::Tournament>(body);
+            std::make_shared<domain::Tournament>(std::move(*decoded));
 
         // importante: usa el id de la URL
         tournament->Id() = id;
 
-        tournamentDelegate->UpdateTournament(id, tournament);
+        std::optional<std::string> version;
+        if (HasIfMatch(request)) {
+            const auto versions = IfMatchVersions(request.get_header_value("if-match"), id);
+            version = versions.empty() ? std::nullopt : tournamentDelegate->UpdateTournamentIfVersion(id, tournament, versions);
+            if (!version) {
+                return crow::response{crow::PRECONDITION_FAILED, "tournament was modified since the given etag"};
+            }
+        } else {
+            version = tournamentDelegate->UpdateTournament(id, tournament);
+        }
 
-        crow::response response;
-        response.code = crow::OK; // tus tests actuales esperan 200 y ya pasan
-        response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+        // same as PUT /tournaments/<id>/groups/<id>: no body, the tag is the one to send in the next If-Match
+        crow::response response{crow::NO_CONTENT};
+        if (!version->empty()) {
+            response.add_header("etag", EntityTag(id, *version));
+        }
         return response;
+    } catch (const ConnectionPoolExhausted& e) {
+        return crow::response{crow::SERVICE_UNAVAILABLE, e.what()};
     } catch (const std::runtime_error& e) {
         return crow::response{crow::NOT_FOUND, e.what()};
     } catch (const std::exception& e) {
@@ -95,5 +178,6 @@ crow::response TournamentController::UpdateTournament(const crow::request& reque
 
 REGISTER_ROUTE(TournamentController, CreateTournament, "/tournaments", "POST"_method)
 REGISTER_ROUTE(TournamentController, ReadAll,          "/tournaments", "GET"_method)
+REGISTER_ROUTE(TournamentController, GetTournament,    "/tournaments/<string>", "GET"_method)
 REGISTER_ROUTE(TournamentController, DeleteTournament, "/tournaments/<string>", "DELETE"_method)
 REGISTER_ROUTE(TournamentController, UpdateTournament, "/tournaments/<string>", "PUT"_method)
@@ -6,7 +6,7 @@
 
 #include <utility>
 
-TeamDelegate::TeamDelegate(std::shared_ptr<IRepository<domain::Team, std::string_view> > repository)
+TeamDelegate::TeamDelegate(std::shared_ptr<ITeamRepository> repository)
     : teamRepository(std::move(repository)) {
 }
 
@@ -14,14 +14,30 @@ std::vector<std::shared_ptr<domain::Team>> TeamDelegate::GetAllTeams() {
     return teamRepository->ReadAll();
 }
 
+Page<domain::Team> TeamDelegate::GetTeamsPage(const PageRequest& page) {
+    return teamRepository->ReadPage(page);
+}
+
+void TeamDelegate::StreamAllTeams(const std::function<void(const domain::Team&)>& consumer) {
+    teamRepository->StreamAll(consumer);
+}
+
 std::shared_ptr<domain::Team> TeamDelegate::GetTeam(std::string_view id) {
     return teamRepository->ReadById(id);
 }
 
+bool TeamDelegate::TeamNameExists(std::string_view name) {
+    return teamRepository->ExistsByName(name);
+}
+
 std::string_view TeamDelegate::SaveTeam(const domain::Team& team){
     return teamRepository->Create(team);
 }
 
+std::vector<TeamImportResult> TeamDelegate::SaveTeams(const std::vector<domain::Team>& teams) {
+    return teamRepository->CreateMany(teams);
+}
+
 // Update: primero verifica existencia; si no existe, NO llama Update.
 // Si el repo lanza (p.ej. "Team not found"), dejamos propagar para que el controller mapee 404.
 void TeamDelegate::UpdateTeam(std::string_view id, const domain::Team& team) {
@@ -8,13 +8,13 @@
 
 #include "delegate/TournamentDelegate.hpp"
 #include "persistence/repository/IRepository.hpp"
-#include "cms/QueueMessageProducer.hpp"
 #include "domain/Tournament.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
 
-TournamentDelegate::TournamentDelegate(
-    std::shared_ptr<IRepository<domain::Tournament, std::string>> repository,
-    std::shared_ptr<QueueMessageProducer> producer)
-    : tournamentRepository(std::move(repository)), producer(std::move(producer)) {}
+// tournament.created/updated/deleted are written to the outbox by the repository, in the same
+// transaction as the change, and published by OutboxRelay
+TournamentDelegate::TournamentDelegate(std::shared_ptr<IRepository<domain::Tournament, std::string>> repository)
+    : tournamentRepository(std::move(repository)) {}
 
 std::string TournamentDelegate::CreateTournament(std::shared_ptr<domain::Tournament> tournament) {
     try {
@@ -27,32 +27,53 @@ std::string TournamentDelegate::CreateTournament(std::shared_ptr<domain::Tournam
             }
         }
 
-        std::string id = tournamentRepository->Create(*tournament);
-
-        if (!id.empty() && producer) {
-            producer->SendMessage(id, "tournament.created");
-        }
-        return id;
+        return tournamentRepository->Create(*tournament);
 
+    } catch (const ConnectionPoolExhausted&) {
+        // no es un fallo de negocio, el controller lo mapea a 503
+        throw;
     } catch (const std::exception&) {
         // Contrato que esperan los tests: en error devuelve "", no propaga
         return std::string{};
     }
 }
 
+std::shared_ptr<domain::Tournament> TournamentDelegate::ReadById(const std::string& id) {
+    return tournamentRepository->ReadById(id);
+}
+
 std::vector<std::shared_ptr<domain::Tournament>> TournamentDelegate::ReadAll() {
     return tournamentRepository->ReadAll();
 }
 
+Page<domain::Tournament> TournamentDelegate::ReadPage(const PageRequest& page) {
+    return tournamentRepository->ReadPage(page);
+}
+
+void TournamentDelegate::StreamAll(const std::function<void(const domain::Tournament&)>& consumer) {
+    tournamentRepository->StreamAll(consumer);
+}
+
 void TournamentDelegate::DeleteTournament(const std::string& id) {
     tournamentRepository->Delete(id);
-    if (producer) producer->SendMessage(id, "tournament.deleted");
 }
 
-void TournamentDelegate::UpdateTournament(const std::string& id, std::shared_ptr<domain::Tournament> tournament) {
-    (void)id; // no lo usamos directamente porque el repo retorna el id
-    std::string updatedId = tournamentRepository->Update(*tournament);
-    if (!updatedId.empty() && producer) {
-        producer->SendMessage(updatedId, "tournament.updated");
-    }
+std::string TournamentDelegate::UpdateTournament(const std::string& id, std::shared_ptr<domain::Tournament> tournament) {
+    (void)id; // no lo usamos directamente, el torneo ya trae el id de la URL
+    return tournamentRepository->UpdateReturningVersion(*tournament);
+}
+
+std::optional<std::string> TournamentDelegate::UpdateTournamentIfVersion(const std::string& id,
+                                                                        std::shared_ptr<domain::Tournament> tournament,
+                                                                        const std::vector<std::string>& versions) {
+    (void)id;
+    return tournamentRepository->UpdateIfVersion(*tournament, versions);
+}
+
+std::string TournamentDelegate::TournamentVersion(const std::string& id) {
+    return tournamentRepository->Version(id);
+}
+
+std::string TournamentDelegate::CollectionVersion() {
+    return tournamentRepository->CollectionVersion();
 }
@@ -0,0 +1,131 @@
+//
+// Politicas de contrapresion de la cola de eventos
+//
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "cms/BackpressureQueue.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+    template<typename T>
+    void Fill(BackpressureQueue<T>& queue, std::initializer_list<T> values) {
+        for (T value : values) {
+            ASSERT_TRUE(queue.Push(value).queued);
+        }
+    }
+
+    template<typename T>
+    std::vector<T> Drain(BackpressureQueue<T>& queue) {
+        std::vector<T> values;
+        queue.PopBatch(values, queue.Capacity());
+        return values;
+    }
+}
+
+// Caso 1: DropNewest descarta el valor nuevo y conserva los encolados
+TEST(BackpressureQueueTest, DropNewest_Full_RejectsPushedValue) {
+    BackpressureQueue<int> queue{2, Backpressure::DropNewest, 0ms};
+    Fill(queue, {1, 2});
+
+    int value = 3;
+    const auto result = queue.Push(value);
+    EXPECT_FALSE(result.queued);
+    EXPECT_EQ(result.evicted, 0u);
+    EXPECT_EQ(Drain(queue), (std::vector{1, 2}));
+}
+
+// Caso 2: DropOldest descarta el más antiguo para hacer sitio
+TEST(BackpressureQueueTest, DropOldest_Full_EvictsOldest) {
+    BackpressureQueue<int> queue{2, Backpressure::DropOldest, 0ms};
+    Fill(queue, {1, 2});
+
+    int value = 3;
+    const auto result = queue.Push(value);
+    EXPECT_TRUE(result.queued);
+    EXPECT_EQ(result.evicted, 1u);
+    EXPECT_EQ(Drain(queue), (std::vector{2, 3}));
+}
+
+// Caso 3: Block sin nadie que consuma se rinde al vencer el timeout
+TEST(BackpressureQueueTest, Block_Full_TimesOut) {
+    BackpressureQueue<int> queue{2, Backpressure::Block, 50ms};
+    Fill(queue, {1, 2});
+
+    int value = 3;
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = queue.Push(value);
+    EXPECT_FALSE(result.queued);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 50ms);
+    EXPECT_EQ(Drain(queue), (std::vector{1, 2}));
+}
+
+// Caso 4: Block espera a que el consumidor libere sitio
+TEST(BackpressureQueueTest, Block_Full_QueuedOnceConsumerPops) {
+    BackpressureQueue<int> queue{2, Backpressure::Block, 10s};
+    Fill(queue, {1, 2});
+
+    auto pushed = std::async(std::launch::async, [&] {
+        int value = 3;
+        return queue.Push(value).queued;
+    });
+    EXPECT_EQ(pushed.wait_for(50ms), std::future_status::timeout);
+
+    std::vector<int> batch;
+    EXPECT_EQ(queue.PopBatch(batch, 1), 1u);
+    EXPECT_TRUE(pushed.get());
+    EXPECT_EQ(Drain(queue), (std::vector{2, 3}));
+}
+
+// Caso 5: Stop libera a los productores bloqueados
+TEST(BackpressureQueueTest, Block_Stop_ReleasesProducer) {
+    BackpressureQueue<int> queue{2, Backpressure::Block, 10s};
+    Fill(queue, {1, 2});
+
+    auto pushed = std::async(std::launch::async, [&] {
+        int value = 3;
+        return queue.Push(value).queued;
+    });
+    EXPECT_EQ(pushed.wait_for(50ms), std::future_status::timeout);
+
+    queue.Stop();
+    EXPECT_FALSE(pushed.get());
+}
+
+// Caso 6: El consumidor dormido despierta con el primer valor y termina al parar con la cola vacía
+TEST(BackpressureQueueTest, WaitForValues_WakesOnPushAndEndsOnStop) {
+    BackpressureQueue<int> queue{4, Backpressure::DropNewest, 0ms};
+    std::promise<void> woke;
+    std::thread consumer([&] {
+        std::vector<int> batch;
+        while (queue.WaitForValues()) {
+            if (queue.PopBatch(batch, 4) > 0) {
+                woke.set_value();
+            }
+        }
+    });
+
+    std::this_thread::sleep_for(20ms);
+    int value = 1;
+    ASSERT_TRUE(queue.Push(value).queued);
+    EXPECT_EQ(woke.get_future().wait_for(5s), std::future_status::ready);
+
+    queue.Stop();
+    consumer.join();
+}
+
+// Caso 7: Tras Stop el consumidor todavía vacia lo encolado antes de terminar
+TEST(BackpressureQueueTest, WaitForValues_AfterStop_DrainsFirst) {
+    BackpressureQueue<int> queue{4, Backpressure::DropNewest, 0ms};
+    Fill(queue, {1, 2});
+    queue.Stop();
+
+    EXPECT_TRUE(queue.WaitForValues());
+    EXPECT_EQ(Drain(queue), (std::vector{1, 2}));
+    EXPECT_FALSE(queue.WaitForValues());
+}
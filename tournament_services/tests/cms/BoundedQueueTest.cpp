@@ -0,0 +1,99 @@
+//
+// Cola acotada MPMC
+//
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cms/BoundedQueue.hpp"
+
+// Caso 1: La capacidad se redondea a potencia de dos
+TEST(BoundedQueueTest, Capacity_RoundedUpToPowerOfTwo) {
+    EXPECT_EQ(BoundedQueue<int>{5}.Capacity(), 8u);
+    EXPECT_EQ(BoundedQueue<int>{8}.Capacity(), 8u);
+    EXPECT_EQ(BoundedQueue<int>{0}.Capacity(), 2u);
+}
+
+// Caso 2: Push y pop devuelven los valores en orden
+TEST(BoundedQueueTest, PushPop_Fifo) {
+    BoundedQueue<std::string> queue{4};
+    for (std::string value : {"a", "b", "c"}) {
+        ASSERT_TRUE(queue.TryPush(value));
+        EXPECT_TRUE(value.empty());
+    }
+    EXPECT_EQ(queue.Size(), 3u);
+
+    std::string value;
+    for (const char* expected : {"a", "b", "c"}) {
+        ASSERT_TRUE(queue.TryPop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_EQ(queue.Size(), 0u);
+}
+
+// Caso 3: Vacía, pop falla y no toca el valor
+TEST(BoundedQueueTest, Pop_Empty_ReturnsFalse) {
+    BoundedQueue<int> queue{2};
+    int value = 7;
+    EXPECT_FALSE(queue.TryPop(value));
+    EXPECT_EQ(value, 7);
+}
+
+// Caso 4: Llena, push falla sin consumir el valor y vuelve a aceptar tras un pop
+TEST(BoundedQueueTest, Push_Full_KeepsValue) {
+    BoundedQueue<std::string> queue{2};
+    std::string first = "1", second = "2", third = "3";
+    ASSERT_TRUE(queue.TryPush(first));
+    ASSERT_TRUE(queue.TryPush(second));
+
+    EXPECT_FALSE(queue.TryPush(third));
+    EXPECT_EQ(third, "3");
+
+    std::string popped;
+    ASSERT_TRUE(queue.TryPop(popped));
+    EXPECT_EQ(popped, "1");
+    EXPECT_TRUE(queue.TryPush(third));
+    EXPECT_EQ(queue.Size(), 2u);
+}
+
+// Caso 5: Varios productores y consumidores, cada valor sale exactamente una vez
+TEST(BoundedQueueTest, ManyThreads_EveryValueOnce) {
+    constexpr int Producers = 4;
+    constexpr int PerProducer = 10000;
+    BoundedQueue<int> queue{64};
+    std::vector<std::atomic<int>> seen(Producers * PerProducer);
+    std::atomic<int> consumed{0};
+
+    std::vector<std::jthread> threads;
+    for (int p = 0; p < Producers; p++) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < PerProducer; i++) {
+                int value = p * PerProducer + i;
+                while (!queue.TryPush(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < 2; c++) {
+        threads.emplace_back([&] {
+            int value;
+            while (consumed.load() < Producers * PerProducer) {
+                if (queue.TryPop(value)) {
+                    seen[value]++;
+                    consumed++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    threads.clear();
+
+    for (const auto& count : seen) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
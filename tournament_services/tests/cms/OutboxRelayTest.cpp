@@ -0,0 +1,98 @@
+//
+// Lotes del OutboxRelay
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "cms/OutboxRelay.hpp"
+#include "BatchSenderMock.hpp"
+#include "OutboxRepositoryMock.hpp"
+
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::InSequence;
+using ::testing::Return;
+using ::testing::StrictMock;
+using ::testing::Throw;
+
+class OutboxRelayTest : public ::testing::Test {
+protected:
+    std::shared_ptr<StrictMock<OutboxRepositoryMock>> repository = std::make_shared<StrictMock<OutboxRepositoryMock>>();
+    std::shared_ptr<StrictMock<BatchSenderMock>> sender = std::make_shared<StrictMock<BatchSenderMock>>();
+    std::shared_ptr<config::OutboxConfiguration> configuration = [] {
+        auto configuration = std::make_shared<config::OutboxConfiguration>();
+        configuration->batchSize = 10;
+        configuration->claimTimeout = std::chrono::milliseconds(30000);
+        return configuration;
+    }();
+    // sin Start(): los lotes se ejecutan a mano
+    std::unique_ptr<OutboxRelay> relay = std::make_unique<OutboxRelay>(repository, sender, configuration);
+};
+
+// Caso 1: Outbox vacío, no toca el broker
+TEST_F(OutboxRelayTest, RelayBatch_Empty_SendsNothing) {
+    EXPECT_CALL(*repository, Claim(10, std::chrono::milliseconds(30000))).WillOnce(Return(std::vector<OutboxEvent>{}));
+
+    EXPECT_EQ(relay->RelayBatch(), 0u);
+}
+
+// Caso 2: Publica en orden, confirma en el broker y solo después borra las filas
+TEST_F(OutboxRelayTest, RelayBatch_Events_SentCommittedThenDeleted) {
+    InSequence order;
+    EXPECT_CALL(*repository, Claim(10, _)).WillOnce(Return(std::vector<OutboxEvent>{
+        {1, "tournament.created", "T1"},
+        {2, "tournament.updated", "T1"},
+    }));
+    EXPECT_CALL(*sender, Send("tournament.created", "T1"));
+    EXPECT_CALL(*sender, Send("tournament.updated", "T1"));
+    EXPECT_CALL(*sender, Commit());
+    EXPECT_CALL(*repository, Delete(ElementsAre(1, 2)));
+
+    EXPECT_EQ(relay->RelayBatch(), 2u);
+}
+
+// Caso 3: El broker falla: se reinicia la sesión, se liberan las filas y no se borran
+TEST_F(OutboxRelayTest, RelayBatch_SendFails_ReleasesClaim) {
+    EXPECT_CALL(*repository, Claim(_, _)).WillOnce(Return(std::vector<OutboxEvent>{
+        {5, "tournament.deleted", "T2"},
+        {6, "tournament.created", "T3"},
+    }));
+    EXPECT_CALL(*sender, Send("tournament.deleted", "T2")).WillOnce(Throw(std::runtime_error("broker down")));
+    EXPECT_CALL(*sender, Reset());
+    EXPECT_CALL(*repository, Release(ElementsAre(5, 6)));
+
+    EXPECT_THROW(relay->RelayBatch(), std::runtime_error);
+}
+
+// Caso 4: Falla el commit del broker: mismo camino que un envío fallido
+TEST_F(OutboxRelayTest, RelayBatch_CommitFails_ReleasesClaim) {
+    EXPECT_CALL(*repository, Claim(_, _)).WillOnce(Return(std::vector<OutboxEvent>{{7, "tournament.created", "T4"}}));
+    EXPECT_CALL(*sender, Send(_, _));
+    EXPECT_CALL(*sender, Commit()).WillOnce(Throw(std::runtime_error("rollback")));
+    EXPECT_CALL(*sender, Reset());
+    EXPECT_CALL(*repository, Release(ElementsAre(7)));
+
+    EXPECT_THROW(relay->RelayBatch(), std::runtime_error);
+}
+
+// Caso 5: Si liberar también falla se propaga el error del broker, la reserva caduca sola
+TEST_F(OutboxRelayTest, RelayBatch_ReleaseFails_RethrowsSendError) {
+    EXPECT_CALL(*repository, Claim(_, _)).WillOnce(Return(std::vector<OutboxEvent>{{8, "tournament.created", "T5"}}));
+    EXPECT_CALL(*sender, Send(_, _)).WillOnce(Throw(std::runtime_error("broker down")));
+    EXPECT_CALL(*sender, Reset());
+    EXPECT_CALL(*repository, Release(_)).WillOnce(Throw(std::logic_error("database down")));
+
+    EXPECT_THROW(relay->RelayBatch(), std::runtime_error);
+}
+
+// Caso 6: La reserva falla: no se envía nada
+TEST_F(OutboxRelayTest, RelayBatch_ClaimFails_Throws) {
+    EXPECT_CALL(*repository, Claim(_, _)).WillOnce(Throw(std::runtime_error("database down")));
+
+    EXPECT_THROW(relay->RelayBatch(), std::runtime_error);
+}
@@ -0,0 +1,96 @@
+//
+// Pool con robo de tareas: reparto, robo y despertar de hilos dormidos
+//
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <latch>
+#include <memory>
+#include <thread>
+
+#include "cms/WorkStealingPool.hpp"
+
+using namespace std::chrono_literals;
+
+// Caso 1: 0 hilos usa uno por hilo de hardware
+TEST(WorkStealingPoolTest, ZeroThreads_OnePerHardwareThread) {
+    WorkStealingPool pool{0};
+    EXPECT_EQ(pool.ThreadCount(), std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// Caso 2: Con todos los hilos dormidos, cada tarea nueva despierta a uno (no se pierde el aviso)
+TEST(WorkStealingPoolTest, ParkedThreads_WokenBySubmit) {
+    WorkStealingPool pool{2};
+    for (int round = 0; round < 200; round++) {
+        // deja que los hilos se duerman entre tareas
+        if (round % 20 == 0) {
+            std::this_thread::sleep_for(5ms);
+        }
+        std::promise<void> ran;
+        pool.Submit([&] { ran.set_value(); });
+        ASSERT_EQ(ran.get_future().wait_for(5s), std::future_status::ready) << "round " << round;
+    }
+}
+
+// Caso 3: Una tarea lenta no retiene las encoladas detrás en su cola: otro hilo las roba
+TEST(WorkStealingPoolTest, BlockedWorker_TasksStolen) {
+    WorkStealingPool pool{2};
+    std::latch release{1};
+    std::promise<void> blocked;
+    std::promise<void> done;
+    std::atomic<int> ran{0};
+
+    pool.Submit([&] {
+        // enviadas desde un hilo del pool, van a su propia cola
+        pool.Submit([&] {
+            if (++ran == 3) {
+                done.set_value();
+            }
+        });
+        pool.Submit([&] {
+            if (++ran == 3) {
+                done.set_value();
+            }
+        });
+        pool.Submit([&] {
+            if (++ran == 3) {
+                done.set_value();
+            }
+        });
+        blocked.set_value();
+        release.wait();
+    });
+    blocked.get_future().wait();
+
+    EXPECT_EQ(done.get_future().wait_for(5s), std::future_status::ready);
+    release.count_down();
+}
+
+// Caso 4: Muchas tareas desde fuera y desde dentro del pool, todas corren exactamente una vez
+TEST(WorkStealingPoolTest, ManyTasks_AllRunOnce) {
+    constexpr int Outer = 1000;
+    std::atomic<int> ran{0};
+    {
+        WorkStealingPool pool{4};
+        for (int i = 0; i < Outer; i++) {
+            pool.Submit([&] {
+                ran++;
+                pool.Submit([&] { ran++; });
+            });
+        }
+    }
+    // el destructor espera a que terminen las encoladas, también las que se encolaron al correr
+    EXPECT_EQ(ran.load(), 2 * Outer);
+}
+
+// Caso 5: Al destruirse con hilos dormidos y nada pendiente termina sin esperar
+TEST(WorkStealingPoolTest, Destroy_ParkedThreads_Returns) {
+    auto pool = std::make_unique<WorkStealingPool>(3);
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(pool->Pending(), 0u);
+
+    auto destroyed = std::async(std::launch::async, [&] { pool.reset(); });
+    EXPECT_EQ(destroyed.wait_for(5s), std::future_status::ready);
+}
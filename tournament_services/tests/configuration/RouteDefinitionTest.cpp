@@ -0,0 +1,75 @@
+//
+// Ruta asíncrona: 503 con la cola llena y 500 ante cualquier excepción
+//
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+#include "configuration/RouteDefinition.hpp"
+
+namespace {
+    struct ThrowingController {
+        crow::response Standard() { throw std::runtime_error("boom"); }
+        crow::response NonStandard() { throw 42; }
+        crow::response Ok(const std::string& id) { return crow::response{crow::OK, id}; }
+    };
+
+    std::shared_ptr<const RouteMetrics> routeMetrics() {
+        return std::make_shared<const RouteMetrics>("/test", crow::HTTPMethod::Get);
+    }
+}
+
+// Caso 1: Executor saturado → 503 en el hilo de crow, sin ejecutar el trabajo
+TEST(RouteDefinitionTest, SubmitRoute_QueueFull_503) {
+    DbExecutor executor{1, 0};
+    crow::request request;
+    crow::response response;
+    bool ran = false;
+
+    submitRoute(executor, routeMetrics(), request, response, [&] {
+        ran = true;
+        return crow::response{crow::OK};
+    });
+
+    EXPECT_EQ(response.code, crow::SERVICE_UNAVAILABLE);
+    EXPECT_TRUE(response.is_completed());
+    EXPECT_FALSE(ran);
+}
+
+// Caso 2: Con sitio en la cola la respuesta se construye en el hilo de base de datos y se termina
+TEST(RouteDefinitionTest, SubmitRoute_Queued_EndsResponse) {
+    crow::request request;
+    crow::response response;
+    {
+        DbExecutor executor{1, 1};
+        submitRoute(executor, routeMetrics(), request, response, [] { return crow::response{crow::OK, "done"}; });
+    }
+    EXPECT_EQ(response.code, crow::OK);
+    EXPECT_EQ(response.body, "done");
+    EXPECT_TRUE(response.is_completed());
+}
+
+// Caso 3: Una petición de una conexión se termina en el io_context de esa conexión
+TEST(RouteDefinitionTest, SubmitRoute_EndsOnConnectionIoContext) {
+    asio::io_context io;
+    crow::request request;
+    request.io_context = &io;
+    crow::response response;
+    {
+        DbExecutor executor{1, 1};
+        submitRoute(executor, routeMetrics(), request, response, [] { return crow::response{crow::OK}; });
+    }
+    EXPECT_FALSE(response.is_completed());
+    io.run();
+    EXPECT_TRUE(response.is_completed());
+}
+
+// Caso 4: Excepciones estándar y no estándar del controlador → 500
+TEST(RouteDefinitionTest, DispatchRoute_Exceptions_500) {
+    ThrowingController controller;
+    crow::request request;
+
+    EXPECT_EQ(dispatchRoute(&controller, &ThrowingController::Standard, request, 1024).code, crow::INTERNAL_SERVER_ERROR);
+    EXPECT_EQ(dispatchRoute(&controller, &ThrowingController::NonStandard, request, 1024).code, crow::INTERNAL_SERVER_ERROR);
+    EXPECT_EQ(dispatchRoute(&controller, &ThrowingController::Ok, request, 1024, std::string{"x"}).body, "x");
+}
@@ -0,0 +1,61 @@
+//
+// Configuración del consumidor por cola
+//
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <nlohmann/json.hpp>
+
+#include "configuration/ConsumerConfiguration.hpp"
+
+// Caso 1: Sin configuración se usan los valores por defecto
+TEST(ConsumerConfigurationTest, Empty_Defaults) {
+    const auto configuration = nlohmann::json::object().get<config::ConsumerConfiguration>();
+
+    EXPECT_EQ(configuration.workers, 0u);
+    EXPECT_EQ(configuration.queueOptions.sessions, 2u);
+    EXPECT_EQ(configuration.queueOptions.ackBatchSize, 32u);
+    EXPECT_EQ(configuration.queueOptions.maxConcurrency, 0u);
+    EXPECT_EQ(configuration.reportInterval, std::chrono::seconds(10));
+    EXPECT_TRUE(configuration.queues.empty());
+}
+
+// Caso 2: Cada cola sobreescribe solo las claves que trae, el resto hereda lo global
+TEST(ConsumerConfigurationTest, Queues_OverrideOnlyTheirKeys) {
+    const auto configuration = nlohmann::json::parse(R"({
+        "workers": 6,
+        "sessionsPerQueue": 3,
+        "ackBatchSize": 16,
+        "maxConcurrency": 5,
+        "reportIntervalSeconds": 0,
+        "queues": {
+            "tournament.created": { "sessions": 4, "maxConcurrency": 8 },
+            "tournament.deleted": { "ackBatchSize": 1 }
+        }
+    })").get<config::ConsumerConfiguration>();
+
+    EXPECT_EQ(configuration.workers, 6u);
+    EXPECT_EQ(configuration.reportInterval, std::chrono::seconds(0));
+
+    const ConsumerOptions& created = configuration.For("tournament.created");
+    EXPECT_EQ(created.sessions, 4u);
+    EXPECT_EQ(created.ackBatchSize, 16u);
+    EXPECT_EQ(created.maxConcurrency, 8u);
+
+    const ConsumerOptions& deleted = configuration.For("tournament.deleted");
+    EXPECT_EQ(deleted.sessions, 3u);
+    EXPECT_EQ(deleted.ackBatchSize, 1u);
+    EXPECT_EQ(deleted.maxConcurrency, 5u);
+}
+
+// Caso 3: Una cola sin entrada usa las opciones globales
+TEST(ConsumerConfigurationTest, For_UnknownQueue_UsesGlobalOptions) {
+    const auto configuration = nlohmann::json::parse(R"({
+        "sessionsPerQueue": 1,
+        "queues": { "tournament.created": { "sessions": 4 } }
+    })").get<config::ConsumerConfiguration>();
+
+    const ConsumerOptions& updated = configuration.For("tournament.updated");
+    EXPECT_EQ(&updated, &configuration.queueOptions);
+    EXPECT_EQ(updated.sessions, 1u);
+}
@@ -0,0 +1,47 @@
+//
+// Registro de handlers por cola
+//
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "handler/HandlerRegistry.hpp"
+
+namespace {
+    class NoopHandler : public IMessageHandler {
+    public:
+        void Handle(const std::string&) override {}
+    };
+}
+
+// Caso 1: Las colas quedan registradas en el orden en que se añadieron
+TEST(HandlerRegistryTest, Register_KeepsOrder) {
+    HandlerRegistry registry;
+    const auto created = std::make_shared<NoopHandler>();
+    const auto deleted = std::make_shared<NoopHandler>();
+    registry.Register("tournament.created", created);
+    registry.Register("tournament.deleted", deleted);
+
+    const auto& registrations = registry.Registrations();
+    ASSERT_EQ(registrations.size(), 2u);
+    EXPECT_EQ(registrations[0].queue, "tournament.created");
+    EXPECT_EQ(registrations[0].handler, created);
+    EXPECT_EQ(registrations[1].queue, "tournament.deleted");
+    EXPECT_EQ(registrations[1].handler, deleted);
+}
+
+// Caso 2: Una cola con dos handlers es un error de configuración
+TEST(HandlerRegistryTest, Register_SameQueueTwice_Throws) {
+    HandlerRegistry registry;
+    registry.Register("tournament.created", std::make_shared<NoopHandler>());
+
+    EXPECT_THROW(registry.Register("tournament.created", std::make_shared<NoopHandler>()), std::logic_error);
+    EXPECT_EQ(registry.Registrations().size(), 1u);
+}
+
+// Caso 3: Sin registros no hay colas que consumir
+TEST(HandlerRegistryTest, Empty_NoRegistrations) {
+    EXPECT_TRUE(HandlerRegistry{}.Registrations().empty());
+}
@@ -0,0 +1,110 @@
+//
+// Eventos de torneo y sus handlers
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "handler/TournamentCreatedHandler.hpp"
+#include "handler/TournamentDeletedHandler.hpp"
+#include "handler/TournamentEvent.hpp"
+#include "handler/TournamentUpdatedHandler.hpp"
+#include "GroupRepositoryMock.hpp"
+#include "TournamentRepositoryMock.hpp"
+
+using ::testing::HasSubstr;
+using ::testing::Return;
+using ::testing::StrictMock;
+
+namespace {
+    constexpr auto TournamentId = "3f2504e0-4f89-11d3-9a0c-0305e82c3301";
+
+    std::shared_ptr<domain::Tournament> Tournament() {
+        return std::make_shared<domain::Tournament>("Copa", domain::TournamentFormat(2, 4, domain::TournamentType::ROUND_ROBIN));
+    }
+}
+
+class TournamentHandlerTest : public ::testing::Test {
+protected:
+    std::shared_ptr<StrictMock<MockTournamentRepository>> tournaments = std::make_shared<StrictMock<MockTournamentRepository>>();
+    std::shared_ptr<StrictMock<GroupRepositoryMock>> groups = std::make_shared<StrictMock<GroupRepositoryMock>>();
+
+    // ejecuta el handler con el payload crudo, como lo hace el consumidor, y devuelve lo impreso
+    static std::string Run(IMessageHandler& handler, const std::string& payload) {
+        testing::internal::CaptureStdout();
+        handler.Handle(payload);
+        return testing::internal::GetCapturedStdout();
+    }
+};
+
+// Caso 1: Decode acepta un uuid y lo conserva tal cual
+TEST(TournamentEventTest, Decode_Uuid_KeepsId) {
+    EXPECT_EQ(TournamentEvent::Decode(TournamentId).tournamentId, TournamentId);
+}
+
+// Caso 2: Decode rechaza lo que no es un uuid
+TEST(TournamentEventTest, Decode_Malformed_Throws) {
+    EXPECT_THROW(TournamentEvent::Decode(""), std::invalid_argument);
+    EXPECT_THROW(TournamentEvent::Decode("T1"), std::invalid_argument);
+    EXPECT_THROW(TournamentEvent::Decode(std::string{TournamentId} + "x"), std::invalid_argument);
+}
+
+// Caso 3: Un payload malformado no llega a consultar el repositorio
+TEST_F(TournamentHandlerTest, Handle_MalformedPayload_ThrowsWithoutReading) {
+    TournamentUpdatedHandler handler{tournaments};
+    IMessageHandler& consumed = handler;
+    EXPECT_THROW(consumed.Handle("not-a-uuid"), std::invalid_argument);
+}
+
+// Caso 4: Creado: cuenta los equipos de los grupos del torneo, no la tabla de equipos
+TEST_F(TournamentHandlerTest, Created_CountsTeamsOfTheTournament) {
+    TournamentCreatedHandler handler{tournaments, groups};
+    EXPECT_CALL(*tournaments, ReadById(std::string{TournamentId})).WillOnce(Return(Tournament()));
+    EXPECT_CALL(*groups, CountTeams(std::string_view{TournamentId})).WillOnce(Return(3));
+
+    EXPECT_THAT(Run(handler, TournamentId), HasSubstr("only 3 of 8 teams assigned"));
+}
+
+// Caso 5: Creado con los grupos llenos
+TEST_F(TournamentHandlerTest, Created_GroupsFull_ReportsEnough) {
+    TournamentCreatedHandler handler{tournaments, groups};
+    EXPECT_CALL(*tournaments, ReadById(std::string{TournamentId})).WillOnce(Return(Tournament()));
+    EXPECT_CALL(*groups, CountTeams(std::string_view{TournamentId})).WillOnce(Return(8));
+
+    EXPECT_THAT(Run(handler, TournamentId), HasSubstr("enough teams assigned"));
+}
+
+// Caso 6: Creado pero ya borrado: no cuenta equipos
+TEST_F(TournamentHandlerTest, Created_AlreadyDeleted_SkipsCount) {
+    TournamentCreatedHandler handler{tournaments, groups};
+    EXPECT_CALL(*tournaments, ReadById(std::string{TournamentId})).WillOnce(Return(nullptr));
+
+    EXPECT_THAT(Run(handler, TournamentId), HasSubstr("already gone"));
+}
+
+// Caso 7: Actualizado informa el estado actual
+TEST_F(TournamentHandlerTest, Updated_ReportsCurrentState) {
+    TournamentUpdatedHandler handler{tournaments};
+    EXPECT_CALL(*tournaments, ReadById(std::string{TournamentId})).WillOnce(Return(Tournament()));
+
+    EXPECT_THAT(Run(handler, TournamentId), HasSubstr("tournament updated: Copa"));
+}
+
+// Caso 8: Borrado con la fila ya eliminada
+TEST_F(TournamentHandlerTest, Deleted_RowGone_ReportsDeleted) {
+    TournamentDeletedHandler handler{tournaments};
+    EXPECT_CALL(*tournaments, ReadById(std::string{TournamentId})).WillOnce(Return(nullptr));
+
+    EXPECT_THAT(Run(handler, TournamentId), HasSubstr("tournament deleted: "));
+}
+
+// Caso 9: Borrado pero la fila sigue guardada
+TEST_F(TournamentHandlerTest, Deleted_RowStillStored_ReportsMismatch) {
+    TournamentDeletedHandler handler{tournaments};
+    EXPECT_CALL(*tournaments, ReadById(std::string{TournamentId})).WillOnce(Return(Tournament()));
+
+    EXPECT_THAT(Run(handler, TournamentId), HasSubstr("still stored"));
+}
@@ -0,0 +1,128 @@
+//
+// Compresión de respuestas según Accept-Encoding
+//
+
+#include <gtest/gtest.h>
+#include <string>
+#include <zlib.h>
+
+#include "controller/Compression.hpp"
+
+// ======== utilidades ========
+static std::string inflateBody(const std::string& body, const int windowBits) {
+    z_stream stream{};
+    inflateInit2(&stream, windowBits);
+    std::string out(1 << 16, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(body.data()));
+    stream.avail_in = static_cast<uInt>(body.size());
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = static_cast<uInt>(out.size());
+    inflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    inflateEnd(&stream);
+    return out;
+}
+
+static std::string repetitiveJson() {
+    std::string body = "[";
+    for (int i = 0; i < 200; i++) {
+        body += R"({"id":"6c2e9e30-7f51-4c58-b185-000000000000","name":"Team"},)";
+    }
+    body.back() = ']';
+    return body;
+}
+
+// Caso 1: Preferencias de Accept-Encoding
+TEST(CompressionTest, AcceptedCoding_FollowsWeights) {
+    EXPECT_EQ(AcceptedCoding(""), ContentCoding::Identity);
+    EXPECT_EQ(AcceptedCoding("gzip, deflate, br"), ContentCoding::Gzip);
+    EXPECT_EQ(AcceptedCoding("deflate, gzip"), ContentCoding::Gzip);
+    EXPECT_EQ(AcceptedCoding("gzip;q=0.5, deflate"), ContentCoding::Deflate);
+    EXPECT_EQ(AcceptedCoding("gzip;q=0, br"), ContentCoding::Identity);
+    EXPECT_EQ(AcceptedCoding("identity"), ContentCoding::Identity);
+}
+
+// Caso 2: gzip de una respuesta grande → se descomprime al cuerpo original
+TEST(CompressionTest, Compress_Gzip_RoundTrips) {
+    crow::request request;
+    request.add_header("accept-encoding", "gzip");
+    const std::string original = repetitiveJson();
+    crow::response response{crow::OK, original};
+
+    Compress(request, response, 1024);
+
+    EXPECT_EQ(response.get_header_value("content-encoding"), "gzip");
+    EXPECT_LT(response.body.size(), original.size() / 4);
+    EXPECT_EQ(inflateBody(response.body, 15 + 16), original);
+
+    // el compresor del hilo se reutiliza en la siguiente respuesta
+    crow::response second{crow::OK, original};
+    Compress(request, second, 1024);
+    EXPECT_EQ(inflateBody(second.body, 15 + 16), original);
+}
+
+// Caso 3: deflate usa el formato zlib
+TEST(CompressionTest, Compress_Deflate_RoundTrips) {
+    crow::request request;
+    request.add_header("accept-encoding", "deflate");
+    const std::string original = repetitiveJson();
+    crow::response response{crow::OK, original};
+
+    Compress(request, response, 1024);
+
+    EXPECT_EQ(response.get_header_value("content-encoding"), "deflate");
+    EXPECT_EQ(inflateBody(response.body, 15), original);
+}
+
+// Caso 4: Cuerpo menor al mínimo o error → se envía sin comprimir
+TEST(CompressionTest, Compress_SmallOrFailed_LeftAlone) {
+    crow::request request;
+    request.add_header("accept-encoding", "gzip");
+
+    crow::response small{crow::OK, std::string(100, 'x')};
+    Compress(request, small, 1024);
+    EXPECT_EQ(small.body, std::string(100, 'x'));
+    EXPECT_TRUE(small.get_header_value("content-encoding").empty());
+
+    crow::response failed{crow::INTERNAL_SERVER_ERROR, repetitiveJson()};
+    Compress(request, failed, 1024);
+    EXPECT_EQ(failed.body, repetitiveJson());
+}
+
+// Caso 5: la etag fuerte de un cuerpo comprimido lleva la codificación
+TEST(CompressionTest, Compress_Gzip_MarksEtag) {
+    crow::request request;
+    request.add_header("accept-encoding", "gzip");
+    crow::response response{crow::OK, repetitiveJson()};
+    response.add_header("etag", R"("5a0c7c1e-5d3f-4a36-9f63-000000000001.1760000000000001-json")");
+
+    Compress(request, response, 1024);
+
+    EXPECT_EQ(response.get_header_value("etag"), R"("5a0c7c1e-5d3f-4a36-9f63-000000000001.1760000000000001-json-gzip")");
+}
+
+// Caso 6: el 304 y el 200 que reemplaza llevan la misma etag, aunque el cuerpo no llegue al mínimo
+TEST(CompressionTest, Compress_NotModified_SameEtagAsOk) {
+    crow::request request;
+    request.add_header("accept-encoding", "gzip");
+    const std::string tag = R"("5a0c7c1e-5d3f-4a36-9f63-000000000001.1760000000000001-json")";
+
+    crow::response small{crow::OK, std::string(100, 'x')};
+    small.add_header("etag", tag);
+    Compress(request, small, 1024);
+
+    crow::response large{crow::OK, repetitiveJson()};
+    large.add_header("etag", tag);
+    Compress(request, large, 1024);
+
+    crow::response notModified{crow::NOT_MODIFIED};
+    notModified.add_header("etag", tag);
+    Compress(request, notModified, 1024);
+
+    const std::string gzipTag = R"("5a0c7c1e-5d3f-4a36-9f63-000000000001.1760000000000001-json-gzip")";
+    EXPECT_EQ(small.get_header_value("etag"), gzipTag);
+    EXPECT_EQ(small.body, std::string(100, 'x'));
+    EXPECT_EQ(large.get_header_value("etag"), gzipTag);
+    EXPECT_EQ(notModified.get_header_value("etag"), gzipTag);
+    EXPECT_EQ(notModified.get_header_value("vary"), "accept-encoding");
+}
@@ -43,9 +43,9 @@ static std::shared_ptr<domain::Group> mkGroup(std::string id, std::string name)
 TEST(GroupControllerTest, CreateGroup_Success_201) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    EXPECT_CALL(*mock, CreateGroup("T1"sv, _))
+    EXPECT_CALL(*mock, CreateGroup("7b1d8d2f-6e40-4b47-a074-000000000001"sv, _))
         .WillOnce(Invoke([](std::string_view tid, const domain::Group& g){
-            EXPECT_EQ(tid, "T1");
+            EXPECT_EQ(tid, "7b1d8d2f-6e40-4b47-a074-000000000001");
             EXPECT_EQ(g.Name(), "Group A");
             EXPECT_EQ(g.Teams().size(), 1u);
             EXPECT_EQ(g.Teams()[0].Id, "team-01");
@@ -54,7 +54,7 @@ TEST(GroupControllerTest, CreateGroup_Success_201) {
 
     GroupController ctl{mock};
     auto req = make_req(R"({"name":"Group A","teams":[{"id":"team-01","name":"Team One"}]})");
-    auto res = ctl.CreateGroup(req, "T1");
+    auto res = ctl.CreateGroup(req, "7b1d8d2f-6e40-4b47-a074-000000000001");
 
     EXPECT_EQ(res.code, crow::CREATED);
     EXPECT_THAT(res.get_header_value("location"), ::testing::HasSubstr("G-123"));
@@ -68,12 +68,12 @@ TEST(GroupControllerTest, CreateGroup_Success_201) {
 TEST(GroupControllerTest, CreateGroup_DBError_409) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    EXPECT_CALL(*mock, CreateGroup("T1"sv, _))
+    EXPECT_CALL(*mock, CreateGroup("7b1d8d2f-6e40-4b47-a074-000000000001"sv, _))
         .WillOnce(Return(std::unexpected("Failed to create group")));
 
     GroupController ctl{mock};
     auto req = make_req(R"({"name":"Group X"})");
-    auto res = ctl.CreateGroup(req, "T1");
+    auto res = ctl.CreateGroup(req, "7b1d8d2f-6e40-4b47-a074-000000000001");
 
     EXPECT_EQ(res.code, 422);
 }
@@ -85,14 +85,16 @@ TEST(GroupControllerTest, CreateGroup_DBError_409) {
 TEST(GroupControllerTest, GetGroup_Found_200) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    auto grp = mkGroup("G1", "Alpha");
-    grp->Teams().push_back(domain::Team{"T1","Team 1"});
+    auto grp = mkGroup("5a0c7c1e-5d3f-4a36-9f63-000000000001", "Alpha");
+    grp->Teams().push_back(domain::Team{"7b1d8d2f-6e40-4b47-a074-000000000001","Team 1"});
 
-    EXPECT_CALL(*mock, GetGroup("T1"sv, "G1"sv))
+    EXPECT_CALL(*mock, GetGroupVersion("7b1d8d2f-6e40-4b47-a074-000000000001"sv, "5a0c7c1e-5d3f-4a36-9f63-000000000001"sv))
+        .WillOnce(Return(""));
+    EXPECT_CALL(*mock, GetGroup("7b1d8d2f-6e40-4b47-a074-000000000001"sv, "5a0c7c1e-5d3f-4a36-9f63-000000000001"sv))
         .WillOnce(Return(grp));
 
     GroupController ctl{mock};
-    auto res = ctl.GetGroup("T1", "G1");
+    auto res = ctl.GetGroup(crow::request{}, "7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-000000000001");
 
     EXPECT_EQ(res.code, crow::OK);
     EXPECT_THAT(res.body, ::testing::HasSubstr("Alpha"));
@@ -106,11 +108,13 @@ TEST(GroupControllerTest, GetGroup_Found_200) {
 TEST(GroupControllerTest, GetGroup_NotFound_404) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    EXPECT_CALL(*mock, GetGroup("T1"sv, "G2"sv))
+    EXPECT_CALL(*mock, GetGroupVersion("7b1d8d2f-6e40-4b47-a074-000000000001"sv, "5a0c7c1e-5d3f-4a36-9f63-000000000002"sv))
+        .WillOnce(Return(""));
+    EXPECT_CALL(*mock, GetGroup("7b1d8d2f-6e40-4b47-a074-000000000001"sv, "5a0c7c1e-5d3f-4a36-9f63-000000000002"sv))
         .WillOnce(Return(std::unexpected("Group doesn't exist")));
 
     GroupController ctl{mock};
-    auto res = ctl.GetGroup("T1", "G2");
+    auto res = ctl.GetGroup(crow::request{}, "7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-000000000002");
 
     EXPECT_EQ(res.code, crow::NOT_FOUND);
 }
@@ -122,17 +126,17 @@ TEST(GroupControllerTest, GetGroup_NotFound_404) {
 TEST(GroupControllerTest, UpdateGroup_Success_204) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    EXPECT_CALL(*mock, UpdateGroup("T1"sv, _))
+    EXPECT_CALL(*mock, UpdateGroup("7b1d8d2f-6e40-4b47-a074-000000000001"sv, _))
         .WillOnce(Invoke([](std::string_view tid, const domain::Group& g){
-            EXPECT_EQ(tid, "T1");
-            EXPECT_EQ(g.Id(), "G1");
+            EXPECT_EQ(tid, "7b1d8d2f-6e40-4b47-a074-000000000001");
+            EXPECT_EQ(g.Id(), "5a0c7c1e-5d3f-4a36-9f63-000000000001");
             EXPECT_EQ(g.Name(), "New Name");
             return std::expected<void, std::string>{};
         }));
 
     GroupController ctl{mock};
     auto req = make_req(R"({"name":"New Name"})");
-    auto res = ctl.UpdateGroup(req, "T1", "G1");
+    auto res = ctl.UpdateGroup(req, "7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-000000000001");
 
     EXPECT_EQ(res.code, crow::NO_CONTENT);
 }
@@ -144,12 +148,12 @@ TEST(GroupControllerTest, UpdateGroup_Success_204) {
 TEST(GroupControllerTest, UpdateGroup_NotFound_404) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    EXPECT_CALL(*mock, UpdateGroup("T1"sv, _))
+    EXPECT_CALL(*mock, UpdateGroup("7b1d8d2f-6e40-4b47-a074-000000000001"sv, _))
         .WillOnce(Return(std::unexpected("Group doesn't exist")));
 
     GroupController ctl{mock};
     auto req = make_req(R"({"name":"X"})");
-    auto res = ctl.UpdateGroup(req, "T1", "G1");
+    auto res = ctl.UpdateGroup(req, "7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-000000000001");
 
     EXPECT_EQ(res.code, crow::NOT_FOUND);
 }
@@ -161,11 +165,11 @@ TEST(GroupControllerTest, UpdateGroup_NotFound_404) {
 TEST(GroupControllerTest, UpdateTeams_AddOneTeam_Success_204) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    EXPECT_CALL(*mock, UpdateTeams("T1"sv, "G1"sv, ::testing::_))
+    EXPECT_CALL(*mock, UpdateTeams("7b1d8d2f-6e40-4b47-a074-000000000001"sv, "5a0c7c1e-5d3f-4a36-9f63-000000000001"sv, ::testing::_))
         .WillOnce(Invoke([](const std::string_view& tid, const std::string_view& gid,
                             const std::vector<domain::Team>& teams){
-            EXPECT_EQ(tid, "T1");
-            EXPECT_EQ(gid, "G1");
+            EXPECT_EQ(tid, "7b1d8d2f-6e40-4b47-a074-000000000001");
+            EXPECT_EQ(gid, "5a0c7c1e-5d3f-4a36-9f63-000000000001");
             EXPECT_EQ(teams.size(), 1u);
             EXPECT_EQ(teams[0].Id, "E1");
             EXPECT_EQ(teams[0].Name, "Team One");
@@ -174,7 +178,7 @@ TEST(GroupControllerTest, UpdateTeams_AddOneTeam_Success_204) {
 
     GroupController ctl{mock};
     auto req = make_req(R"([{"id":"E1","name":"Team One"}])");
-    auto res = ctl.UpdateTeams(req, "T1", "G1");
+    auto res = ctl.UpdateTeams(req, "7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-000000000001");
 
     EXPECT_EQ(res.code, crow::NO_CONTENT);
 }
@@ -186,12 +190,12 @@ TEST(GroupControllerTest, UpdateTeams_AddOneTeam_Success_204) {
 TEST(GroupControllerTest, UpdateTeams_TeamNotExist_422) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    EXPECT_CALL(*mock, UpdateTeams("T1"sv, "G1"sv, ::testing::_))
+    EXPECT_CALL(*mock, UpdateTeams("7b1d8d2f-6e40-4b47-a074-000000000001"sv, "5a0c7c1e-5d3f-4a36-9f63-000000000001"sv, ::testing::_))
         .WillOnce(Return(std::unexpected("Team E999 doesn't exist")));
 
     GroupController ctl{mock};
     auto req = make_req(R"([{"id":"E999","name":"Ghost Team"}])");
-    auto res = ctl.UpdateTeams(req, "T1", "G1");
+    auto res = ctl.UpdateTeams(req, "7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-000000000001");
 
     EXPECT_EQ(res.code, 422);
 }
@@ -203,12 +207,12 @@ TEST(GroupControllerTest, UpdateTeams_TeamNotExist_422) {
 TEST(GroupControllerTest, UpdateTeams_GroupFull_422) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    EXPECT_CALL(*mock, UpdateTeams("T1"sv, "G1"sv, ::testing::_))
+    EXPECT_CALL(*mock, UpdateTeams("7b1d8d2f-6e40-4b47-a074-000000000001"sv, "5a0c7c1e-5d3f-4a36-9f63-000000000001"sv, ::testing::_))
         .WillOnce(Return(std::unexpected("Group at max capacity")));
 
     GroupController ctl{mock};
     auto req = make_req(R"([{"id":"E3","name":"Team Three"}])");
-    auto res = ctl.UpdateTeams(req, "T1", "G1");
+    auto res = ctl.UpdateTeams(req, "7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-000000000001");
 
     EXPECT_EQ(res.code, 422);
 }
@@ -219,11 +223,11 @@ TEST(GroupControllerTest, UpdateTeams_GroupFull_422) {
 TEST(GroupControllerTest, DeleteGroup_Success_204) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    EXPECT_CALL(*mock, RemoveGroup("T1"sv, "G1"sv))
+    EXPECT_CALL(*mock, RemoveGroup("7b1d8d2f-6e40-4b47-a074-000000000001"sv, "5a0c7c1e-5d3f-4a36-9f63-000000000001"sv))
         .WillOnce(Return(std::expected<void, std::string>{}));
 
     GroupController ctl{mock};
-    auto res = ctl.DeleteGroup("T1", "G1");
+    auto res = ctl.DeleteGroup("7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-000000000001");
 
     EXPECT_EQ(res.code, crow::NO_CONTENT);
 }
@@ -231,11 +235,11 @@ TEST(GroupControllerTest, DeleteGroup_Success_204) {
 TEST(GroupControllerTest, DeleteGroup_NotFound_404) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    EXPECT_CALL(*mock, RemoveGroup("T1"sv, "Gx"sv))
+    EXPECT_CALL(*mock, RemoveGroup("7b1d8d2f-6e40-4b47-a074-000000000001"sv, "5a0c7c1e-5d3f-4a36-9f63-0000000000ff"sv))
         .WillOnce(Return(std::unexpected("Group doesn't exist")));
 
     GroupController ctl{mock};
-    auto res = ctl.DeleteGroup("T1", "Gx");
+    auto res = ctl.DeleteGroup("7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-0000000000ff");
 
     EXPECT_EQ(res.code, crow::NOT_FOUND);
 }
@@ -243,29 +247,29 @@ TEST(GroupControllerTest, DeleteGroup_NotFound_404) {
 TEST(GroupControllerTest, GetGroups_Success_200) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    auto g1 = mkGroup("G1","A");
-    g1->Teams().push_back(domain::Team{"T1","One"});
-    auto g2 = mkGroup("G2","B");
+    auto g1 = mkGroup("5a0c7c1e-5d3f-4a36-9f63-000000000001","A");
+    g1->Teams().push_back(domain::Team{"7b1d8d2f-6e40-4b47-a074-000000000001","One"});
+    auto g2 = mkGroup("5a0c7c1e-5d3f-4a36-9f63-000000000002","B");
 
-    EXPECT_CALL(*mock, GetGroups("T1"sv))
+    EXPECT_CALL(*mock, GetGroups("7b1d8d2f-6e40-4b47-a074-000000000001"sv))
         .WillOnce(Return(std::vector<std::shared_ptr<domain::Group>>{g1, g2}));
 
     GroupController ctl{mock};
-    auto res = ctl.GetGroups("T1");
+    auto res = ctl.GetGroups(crow::request{}, "7b1d8d2f-6e40-4b47-a074-000000000001");
 
     EXPECT_EQ(res.code, crow::OK);
-    EXPECT_THAT(res.body, ::testing::HasSubstr("\"G1\""));
+    EXPECT_THAT(res.body, ::testing::HasSubstr("\"5a0c7c1e-5d3f-4a36-9f63-000000000001\""));
     EXPECT_THAT(res.body, ::testing::HasSubstr("teams"));
 }
 
 TEST(GroupControllerTest, UpdateTeams_Success_204) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
 
-    EXPECT_CALL(*mock, UpdateTeams("T1"sv, "G1"sv, ::testing::_))
+    EXPECT_CALL(*mock, UpdateTeams("7b1d8d2f-6e40-4b47-a074-000000000001"sv, "5a0c7c1e-5d3f-4a36-9f63-000000000001"sv, ::testing::_))
         .WillOnce(Invoke([](const std::string_view& tid, const std::string_view& gid,
                             const std::vector<domain::Team>& teams){
-            EXPECT_EQ(tid, "T1");
-            EXPECT_EQ(gid, "G1");
+            EXPECT_EQ(tid, "7b1d8d2f-6e40-4b47-a074-000000000001");
+            EXPECT_EQ(gid, "5a0c7c1e-5d3f-4a36-9f63-000000000001");
             EXPECT_EQ(teams.size(), 2u);
             EXPECT_EQ(teams[0].Id, "A");
             EXPECT_EQ(teams[1].Id, "B");
@@ -274,7 +278,53 @@ TEST(GroupControllerTest, UpdateTeams_Success_204) {
 
     GroupController ctl{mock};
     auto req = make_req(R"([{"id":"A","name":"Alpha"},{"id":"B"}])");
-    auto res = ctl.UpdateTeams(req, "T1", "G1");
+    auto res = ctl.UpdateTeams(req, "7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-000000000001");
 
     EXPECT_EQ(res.code, crow::NO_CONTENT);
-}
\ No newline at end of file
+}
+TEST(GroupControllerTest, GetGroup_MalformedId_400WithoutDelegate) {
+    auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
+
+    GroupController ctl{mock};
+    auto res = ctl.GetGroup(crow::request{}, "7b1d8d2f-6e40-4b47-a074-000000000001", "G1");
+
+    EXPECT_EQ(res.code, crow::BAD_REQUEST);
+}
+
+/*
+   GET condicional de un grupo: If-None-Match con la etag vigente
+   responde 304 sin leer el documento del grupo
+*/
+TEST(GroupControllerTest, GetGroup_IfNoneMatchCurrent_304WithoutReading) {
+    auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
+
+    EXPECT_CALL(*mock, GetGroupVersion("7b1d8d2f-6e40-4b47-a074-000000000001"sv, "5a0c7c1e-5d3f-4a36-9f63-000000000001"sv))
+        .WillOnce(Return("1760000000000001"));
+
+    GroupController ctl{mock};
+    crow::request req;
+    req.add_header("if-none-match", R"(W/"5a0c7c1e-5d3f-4a36-9f63-000000000001.1760000000000001-json-gzip")");
+    auto res = ctl.GetGroup(req, "7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-000000000001");
+
+    EXPECT_EQ(res.code, crow::NOT_MODIFIED);
+    EXPECT_TRUE(res.body.empty());
+    EXPECT_EQ(res.get_header_value("etag"), R"("5a0c7c1e-5d3f-4a36-9f63-000000000001.1760000000000001-json")");
+}
+
+/*
+   PUT condicional de un grupo: If-Match con una version vieja
+   responde 412 y no se aplica el cambio
+*/
+TEST(GroupControllerTest, UpdateGroup_IfMatchStale_412) {
+    auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
+
+    EXPECT_CALL(*mock, UpdateGroupIfVersion("7b1d8d2f-6e40-4b47-a074-000000000001"sv, _, std::vector<std::string>{"1760000000000001"}))
+        .WillOnce(Return(std::optional<std::string>{}));
+
+    GroupController ctl{mock};
+    auto req = make_req(R"({"name":"New Name"})");
+    req.add_header("if-match", R"("5a0c7c1e-5d3f-4a36-9f63-000000000001.1760000000000001-json")");
+    auto res = ctl.UpdateGroup(req, "7b1d8d2f-6e40-4b47-a074-000000000001", "5a0c7c1e-5d3f-4a36-9f63-000000000001");
+
+    EXPECT_EQ(res.code, crow::PRECONDITION_FAILED);
+}
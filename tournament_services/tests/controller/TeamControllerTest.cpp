@@ -11,7 +11,9 @@
 #include <nlohmann/json.hpp>
 
 #include "controller/TeamController.hpp"
+#include "controller/ContentNegotiation.hpp"
 #include "../mocks/TeamDelegateMock.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
 
 using ::testing::StrictMock;
 using ::testing::NiceMock;
@@ -40,8 +42,8 @@ TEST(TeamControllerSpec, CreateTeam_ValidJson_Returns201) {
     auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
     TeamController controller{mock};
 
-    EXPECT_CALL(*mock, GetAllTeams())
-        .WillOnce(Return(std::vector<std::shared_ptr<domain::Team>>{}));
+    EXPECT_CALL(*mock, TeamNameExists(::testing::_))
+        .WillOnce(Return(false));
     EXPECT_CALL(*mock, SaveTeam(::testing::_))
         .WillOnce(Return(std::string_view{"NEW-99"}));
 
@@ -60,10 +62,8 @@ TEST(TeamControllerSpec, CreateTeam_DuplicateName_409Conflict) {
     auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
     TeamController controller{mock};
 
-    EXPECT_CALL(*mock, GetAllTeams())
-        .WillOnce(Return(std::vector{
-            fakeTeam("X1", "Panthers")
-        }));
+    EXPECT_CALL(*mock, TeamNameExists("Panthers"sv))
+        .WillOnce(Return(true));
 
     auto req = makeRequest(R"({"name":"Panthers"})");
     auto res = controller.SaveTeam(req);
@@ -79,8 +79,8 @@ TEST(TeamControllerSpec, CreateTeam_InsertThrows_InternalError500) {
     auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
     TeamController controller{mock};
 
-    EXPECT_CALL(*mock, GetAllTeams())
-        .WillOnce(Return(std::vector<std::shared_ptr<domain::Team>>{}));
+    EXPECT_CALL(*mock, TeamNameExists(::testing::_))
+        .WillOnce(Return(false));
     EXPECT_CALL(*mock, SaveTeam(::testing::_))
         .WillOnce(Invoke([](const domain::Team&) -> std::string_view {
             throw std::runtime_error("insertion error");
@@ -100,16 +100,25 @@ TEST(TeamControllerSpec, CreateTeam_InvalidJsonSyntax_400) {
     EXPECT_EQ(res.code, crow::BAD_REQUEST);
 }
 
+// Caso 5b: Falta "name" → 400 indicando el campo
+TEST(TeamControllerSpec, CreateTeam_MissingName_400PointsAtField) {
+    auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
+    TeamController ctl{mock};
+    auto res = ctl.SaveTeam(makeRequest(R"({"id":"T1"})"));
+    EXPECT_EQ(res.code, crow::BAD_REQUEST);
+    EXPECT_THAT(std::string(res.body), ::testing::HasSubstr("/name"));
+}
+
 // Requisito #7: Actualización exitosa → HTTP 204
 TEST(TeamControllerSpec, UpdateTeam_ValidData_Returns204) {
     auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
     TeamController controller{mock};
 
-    EXPECT_CALL(*mock, UpdateTeam("U1"sv, ::testing::_))
+    EXPECT_CALL(*mock, UpdateTeam("6c2e9e30-7f51-4c58-b185-000000000002"sv, ::testing::_))
         .Times(1);
 
     auto req = makeRequest(R"({"name":"Updated Name"})");
-    auto res = controller.UpdateTeam(req, "U1");
+    auto res = controller.UpdateTeam(req, "6c2e9e30-7f51-4c58-b185-000000000002");
 
     EXPECT_EQ(res.code, crow::NO_CONTENT); // 204
 }
@@ -119,11 +128,11 @@ TEST(TeamControllerSpec, UpdateTeam_NotFound_Returns404) {
     auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
     TeamController controller{mock};
 
-    EXPECT_CALL(*mock, UpdateTeam("NF"sv, ::testing::_))
+    EXPECT_CALL(*mock, UpdateTeam("6c2e9e30-7f51-4c58-b185-0000000000ff"sv, ::testing::_))
         .WillOnce(testing::Throw(std::runtime_error("Team not found")));
 
     auto req = makeRequest(R"({"name":"Name"})");
-    auto res = controller.UpdateTeam(req, "NF");
+    auto res = controller.UpdateTeam(req, "6c2e9e30-7f51-4c58-b185-0000000000ff");
 
     EXPECT_EQ(res.code, crow::NOT_FOUND);
 }
@@ -133,8 +142,8 @@ TEST(TeamControllerSpec, CreateTeam_InsertionError_Returns409) {
     auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
     TeamController controller{mock};
 
-    EXPECT_CALL(*mock, GetAllTeams())
-        .WillOnce(Return(std::vector<std::shared_ptr<domain::Team>>{}));
+    EXPECT_CALL(*mock, TeamNameExists(::testing::_))
+        .WillOnce(Return(false));
     EXPECT_CALL(*mock, SaveTeam(::testing::_))
         .WillOnce(testing::Throw(std::runtime_error("Database constraint violation")));
 
@@ -151,26 +160,26 @@ TEST(TeamControllerSpec, CreateTeam_InsertionError_Returns409) {
 // Caso 6: Buscar por ID válido → 200
 TEST(TeamControllerSpec, GetTeam_Found_ReturnsJson200) {
     auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
-    EXPECT_CALL(*mock, GetTeam("T01"sv))
-        .WillOnce(Return(fakeTeam("T01", "Bulls")));
+    EXPECT_CALL(*mock, GetTeam("6c2e9e30-7f51-4c58-b185-000000000001"sv))
+        .WillOnce(Return(fakeTeam("6c2e9e30-7f51-4c58-b185-000000000001", "Bulls")));
 
     TeamController controller{mock};
-    auto res = controller.getTeam("T01");
+    auto res = controller.getTeam("6c2e9e30-7f51-4c58-b185-000000000001");
 
     EXPECT_EQ(res.code, crow::OK);
     EXPECT_THAT(res.get_header_value("content-type"), ::testing::HasSubstr("application/json"));
     json parsed = json::parse(res.body);
-    EXPECT_EQ(parsed.at("id"), "T01");
+    EXPECT_EQ(parsed.at("id"), "6c2e9e30-7f51-4c58-b185-000000000001");
     EXPECT_EQ(parsed.at("name"), "Bulls");
 }
 
 // Caso 7: Buscar por ID no existente → 404
 TEST(TeamControllerSpec, GetTeam_NotFound_Returns404) {
     auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
-    EXPECT_CALL(*mock, GetTeam("NF"sv)).WillOnce(Return(nullptr));
+    EXPECT_CALL(*mock, GetTeam("6c2e9e30-7f51-4c58-b185-0000000000ff"sv)).WillOnce(Return(nullptr));
 
     TeamController controller{mock};
-    auto res = controller.getTeam("NF");
+    auto res = controller.getTeam("6c2e9e30-7f51-4c58-b185-0000000000ff");
     EXPECT_EQ(res.code, crow::NOT_FOUND);
 }
 
@@ -189,7 +198,7 @@ TEST(TeamControllerSpec, GetAllTeams_Empty_ReturnsEmptyJsonArray) {
         .WillOnce(Return(std::vector<std::shared_ptr<domain::Team>>{}));
 
     TeamController ctl{mock};
-    auto res = ctl.getAllTeams();
+    auto res = ctl.getAllTeams(crow::request{});
 
     EXPECT_EQ(res.code, crow::OK);
     EXPECT_EQ(res.body, "[]");
@@ -206,14 +215,99 @@ TEST(TeamControllerSpec, GetAllTeams_WithData_ReturnsJsonArray200) {
     EXPECT_CALL(*mock, GetAllTeams()).WillOnce(Return(fakeData));
 
     TeamController ctl{mock};
-    auto res = ctl.getAllTeams();
+    auto res = ctl.getAllTeams(crow::request{});
+
+    EXPECT_EQ(res.code, crow::OK);
+    json arr = json::parse(res.body);
+    ASSERT_EQ(arr.size(), 2u);
+    EXPECT_EQ(arr[1].at("name"), "Wolves");
+}
+
+// Caso 10b: Página con limit → 200, solo esa página y cursor para la siguiente
+TEST(TeamControllerSpec, GetAllTeams_WithLimit_ReturnsPageAndCursor) {
+    auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
+    Page<domain::Team> page{{fakeTeam("A1", "Eagles"), fakeTeam("B2", "Wolves")}, "next-cursor"};
+    EXPECT_CALL(*mock, GetTeamsPage(::testing::Field(&PageRequest::limit, 2u))).WillOnce(Return(page));
+
+    crow::request req;
+    req.url_params = crow::query_string("/teams?limit=2");
+    TeamController ctl{mock};
+    auto res = ctl.getAllTeams(req);
+
+    EXPECT_EQ(res.code, crow::OK);
+    EXPECT_EQ(json::parse(res.body).size(), 2u);
+    EXPECT_EQ(res.get_header_value("x-next-cursor"), "next-cursor");
+}
+
+// Caso 10c: limit fuera de rango → 400 sin tocar el delegate
+TEST(TeamControllerSpec, GetAllTeams_InvalidLimit_Returns400) {
+    auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
+
+    crow::request req;
+    req.url_params = crow::query_string("/teams?limit=0");
+    TeamController ctl{mock};
+    auto res = ctl.getAllTeams(req);
+
+    EXPECT_EQ(res.code, crow::BAD_REQUEST);
+}
+
+// Caso 10d: Carga masiva → un resultado por equipo, en el mismo orden, duplicados marcados
+TEST(TeamControllerSpec, SaveTeams_ReportsIdsAndDuplicatesInInputOrder) {
+    auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
+    EXPECT_CALL(*mock, SaveTeams(::testing::SizeIs(3)))
+        .WillOnce(Return(std::vector<TeamImportResult>{{"id-1", false}, {"", true}, {"id-3", false}}));
+
+    TeamController ctl{mock};
+    auto res = ctl.SaveTeams(makeRequest(R"([{"name":"Eagles"},{"name":"Wolves"},{"name":"Bears"}])"));
 
     EXPECT_EQ(res.code, crow::OK);
     json arr = json::parse(res.body);
+    ASSERT_EQ(arr.size(), 3u);
+    EXPECT_EQ(arr[0].at("id"), "id-1");
+    EXPECT_EQ(arr[1].at("name"), "Wolves");
+    EXPECT_TRUE(arr[1].contains("error"));
+    EXPECT_EQ(arr[2].at("id"), "id-3");
+}
+
+// Caso 10e: Accept CBOR (el binder abre el scope) → lista en CBOR, decodificable por nlohmann
+TEST(TeamControllerSpec, GetAllTeams_AcceptCbor_ReturnsCborArray) {
+    auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
+    std::vector<std::shared_ptr<domain::Team>> fakeData{
+        fakeTeam("A1", "Eagles"),
+        fakeTeam("B2", "Wolves")
+    };
+    EXPECT_CALL(*mock, GetAllTeams()).WillOnce(Return(fakeData));
+
+    TeamController ctl{mock};
+    const ResponseFormatScope scope{AcceptedFormat("application/json;q=0.5, application/cbor")};
+    auto res = ctl.getAllTeams(crow::request{});
+
+    EXPECT_EQ(res.code, crow::OK);
+    EXPECT_EQ(res.get_header_value("content-type"), "application/cbor");
+    json arr = json::from_cbor(res.body);
     ASSERT_EQ(arr.size(), 2u);
     EXPECT_EQ(arr[1].at("name"), "Wolves");
 }
 
+// Caso 10f: Cuerpo MessagePack según content-type → se decodifica igual que el JSON
+TEST(TeamControllerSpec, CreateTeam_MessagePackBody_Returns201) {
+    auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
+    TeamController controller{mock};
+
+    EXPECT_CALL(*mock, TeamNameExists("Falcons"sv))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*mock, SaveTeam(::testing::Field(&domain::Team::Name, "Falcons")))
+        .WillOnce(Return(std::string_view{"NEW-7"}));
+
+    const auto packed = json::to_msgpack(json{{"name", "Falcons"}});
+    auto req = makeRequest(std::string(packed.begin(), packed.end()));
+    req.add_header("content-type", "application/msgpack");
+    auto res = controller.SaveTeam(req);
+
+    EXPECT_EQ(res.code, crow::CREATED);
+    EXPECT_EQ(res.get_header_value("location"), "NEW-7");
+}
+
 // =========================================================
 // ACTUALIZACIÓN Y ELIMINACIÓN
 // =========================================================
@@ -230,7 +324,7 @@ TEST(TeamControllerSpec, UpdateTeam_InvalidId_400) {
 TEST(TeamControllerSpec, UpdateTeam_BadJson_400) {
     auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
     TeamController ctl{mock};
-    auto res = ctl.UpdateTeam(makeRequest("{wrong json"), "U1");
+    auto res = ctl.UpdateTeam(makeRequest("{wrong json"), "6c2e9e30-7f51-4c58-b185-000000000002");
     EXPECT_EQ(res.code, crow::BAD_REQUEST);
 }
 
@@ -247,11 +341,23 @@ TEST(TeamControllerSpec, DeleteTeam_InternalException_500) {
     auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
     TeamController ctl{mock};
 
-    EXPECT_CALL(*mock, DeleteTeam("X1"sv))
+    EXPECT_CALL(*mock, DeleteTeam("6c2e9e30-7f51-4c58-b185-000000000003"sv))
         .WillOnce(Invoke([](std::string_view) -> void {
             throw std::runtime_error("db failure");
         }));
 
-    auto res = ctl.DeleteTeam("X1");
+    auto res = ctl.DeleteTeam("6c2e9e30-7f51-4c58-b185-000000000003");
     EXPECT_EQ(res.code, crow::INTERNAL_SERVER_ERROR);
-}
\ No newline at end of file
+}
+
+// Caso 15: pool de conexiones agotado → 503
+TEST(TeamControllerSpec, UpdateTeam_PoolExhausted_Returns503) {
+    auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
+    TeamController ctl{mock};
+
+    EXPECT_CALL(*mock, UpdateTeam("6c2e9e30-7f51-4c58-b185-000000000002"sv, ::testing::_))
+        .WillOnce(testing::Throw(ConnectionPoolExhausted("no database connection available")));
+
+    auto res = ctl.UpdateTeam(makeRequest(R"({"name":"X"})"), "6c2e9e30-7f51-4c58-b185-000000000002");
+    EXPECT_EQ(res.code, crow::SERVICE_UNAVAILABLE);
+}
@@ -62,7 +62,7 @@ TEST_F(TournamentControllerTest, ReadAll_200_WithItems) {
 
     EXPECT_CALL(*mockDelegate, ReadAll()).WillOnce(Return(list));
 
-    auto resp = controller->ReadAll();
+    auto resp = controller->ReadAll(crow::request{});
     EXPECT_EQ(resp.code, crow::OK);
 
     auto j = nlohmann::json::parse(resp.body);
@@ -74,7 +74,7 @@ TEST_F(TournamentControllerTest, ReadAll_200_Empty) {
     EXPECT_CALL(*mockDelegate, ReadAll())
         .WillOnce(Return(std::vector<std::shared_ptr<domain::Tournament>>{}));
 
-    auto resp = controller->ReadAll();
+    auto resp = controller->ReadAll(crow::request{});
     EXPECT_EQ(resp.code, crow::OK);
 
     auto j = nlohmann::json::parse(resp.body);
@@ -82,16 +82,19 @@ TEST_F(TournamentControllerTest, ReadAll_200_Empty) {
     EXPECT_TRUE(j.empty());
 }
 
-// PUT/PATCH /tournaments/<id> -> OK (tu controller expone UpdateTournament)
-TEST_F(TournamentControllerTest, UpdateTournament_200_OK) {
+// PUT /tournaments/<id> -> 204 sin cuerpo, con el etag de la nueva versión
+TEST_F(TournamentControllerTest, UpdateTournament_204_WithEtag) {
     nlohmann::json body = { {"name","TOURNAMENT NAME UPDATE"} };
     crow::request req; req.body = body.dump();
 
-    EXPECT_CALL(*mockDelegate, UpdateTournament("tid-42", _)).Times(1);
+    EXPECT_CALL(*mockDelegate, UpdateTournament("7b1d8d2f-6e40-4b47-a074-000000000042", _))
+        .WillOnce(Return("1760000000000002"));
 
-    auto resp = controller->UpdateTournament(req, "tid-42");
-    // tu controlador actualmente responde 200 OK
-    EXPECT_EQ(resp.code, crow::OK);
+    auto resp = controller->UpdateTournament(req, "7b1d8d2f-6e40-4b47-a074-000000000042");
+    EXPECT_EQ(resp.code, crow::NO_CONTENT);
+    EXPECT_TRUE(resp.body.empty());
+    EXPECT_TRUE(resp.get_header_value("content-type").empty());
+    EXPECT_EQ(resp.get_header_value("etag"), R"("7b1d8d2f-6e40-4b47-a074-000000000042.1760000000000002-json")");
 }
 
 // PUT/PATCH /tournaments/<id> -> 404 si el delegate avisa not found
@@ -99,9 +102,90 @@ TEST_F(TournamentControllerTest, UpdateTournament_404_NotFound) {
     nlohmann::json body = { {"name","X"} };
     crow::request req; req.body = body.dump();
 
-    EXPECT_CALL(*mockDelegate, UpdateTournament("nope", _))
+    EXPECT_CALL(*mockDelegate, UpdateTournament("7b1d8d2f-6e40-4b47-a074-0000000000ff", _))
         .WillOnce(Throw(std::runtime_error("not found")));
 
-    auto resp = controller->UpdateTournament(req, "nope");
+    auto resp = controller->UpdateTournament(req, "7b1d8d2f-6e40-4b47-a074-0000000000ff");
     EXPECT_EQ(resp.code, crow::NOT_FOUND);
 }
+
+// GET /tournaments con If-None-Match vigente -> 304 sin leer los torneos
+TEST_F(TournamentControllerTest, ReadAll_IfNoneMatchCurrent_304WithoutReading) {
+    EXPECT_CALL(*mockDelegate, CollectionVersion()).WillOnce(Return("2.1760000000000001"));
+    EXPECT_CALL(*mockDelegate, ReadAll()).Times(0);
+
+    crow::request req;
+    req.add_header("if-none-match", R"("tournaments.2.1760000000000001-json")");
+    auto resp = controller->ReadAll(req);
+
+    EXPECT_EQ(resp.code, crow::NOT_MODIFIED);
+    EXPECT_TRUE(resp.body.empty());
+}
+
+// PUT /tournaments/<id> con If-Match viejo -> 412
+TEST_F(TournamentControllerTest, UpdateTournament_IfMatchStale_412) {
+    nlohmann::json body = { {"name","X"} };
+    crow::request req; req.body = body.dump();
+    req.add_header("if-match", R"("7b1d8d2f-6e40-4b47-a074-000000000042.1760000000000001-json")");
+
+    EXPECT_CALL(*mockDelegate, UpdateTournamentIfVersion("7b1d8d2f-6e40-4b47-a074-000000000042", _, std::vector<std::string>{"1760000000000001"}))
+        .WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*mockDelegate, UpdateTournament(_, _)).Times(0);
+
+    auto resp = controller->UpdateTournament(req, "7b1d8d2f-6e40-4b47-a074-000000000042");
+    EXPECT_EQ(resp.code, crow::PRECONDITION_FAILED);
+}
+
+// DELETE /tournaments/<id> -> 400 si el id no es un UUID, sin llegar al delegate
+TEST_F(TournamentControllerTest, DeleteTournament_MalformedId_400) {
+    EXPECT_CALL(*mockDelegate, DeleteTournament(_)).Times(0);
+
+    auto resp = controller->DeleteTournament("tid-42");
+    EXPECT_EQ(resp.code, crow::BAD_REQUEST);
+}
+
+// GET /tournaments/<id> -> 200 con el etag de la fila
+TEST_F(TournamentControllerTest, GetTournament_200_WithEtag) {
+    auto t = std::make_shared<domain::Tournament>("A"); t->Id() = "7b1d8d2f-6e40-4b47-a074-000000000042";
+
+    EXPECT_CALL(*mockDelegate, TournamentVersion("7b1d8d2f-6e40-4b47-a074-000000000042")).WillOnce(Return("1760000000000001"));
+    EXPECT_CALL(*mockDelegate, ReadById("7b1d8d2f-6e40-4b47-a074-000000000042")).WillOnce(Return(t));
+
+    auto resp = controller->GetTournament(crow::request{}, "7b1d8d2f-6e40-4b47-a074-000000000042");
+    EXPECT_EQ(resp.code, crow::OK);
+    EXPECT_EQ(nlohmann::json::parse(resp.body)["name"], "A");
+    EXPECT_EQ(resp.get_header_value("etag"), R"("7b1d8d2f-6e40-4b47-a074-000000000042.1760000000000001-json")");
+}
+
+// GET /tournaments/<id> -> 404 si no existe
+TEST_F(TournamentControllerTest, GetTournament_NotFound_404) {
+    EXPECT_CALL(*mockDelegate, TournamentVersion(_)).WillOnce(Return(""));
+    EXPECT_CALL(*mockDelegate, ReadById(_)).WillOnce(Return(nullptr));
+
+    auto resp = controller->GetTournament(crow::request{}, "7b1d8d2f-6e40-4b47-a074-0000000000ff");
+    EXPECT_EQ(resp.code, crow::NOT_FOUND);
+}
+
+// El etag de un GET sirve como If-Match del PUT, y el del PUT para el siguiente
+TEST_F(TournamentControllerTest, UpdateTournament_IfMatchFromPreviousResponses_204) {
+    const std::string id = "7b1d8d2f-6e40-4b47-a074-000000000042";
+    auto t = std::make_shared<domain::Tournament>("A"); t->Id() = id;
+    EXPECT_CALL(*mockDelegate, TournamentVersion(id)).WillOnce(Return("1760000000000001"));
+    EXPECT_CALL(*mockDelegate, ReadById(id)).WillOnce(Return(t));
+    const std::string readTag = controller->GetTournament(crow::request{}, id).get_header_value("etag");
+
+    EXPECT_CALL(*mockDelegate, UpdateTournamentIfVersion(id, _, std::vector<std::string>{"1760000000000001"}))
+        .WillOnce(Return(std::optional<std::string>{"1760000000000002"}));
+    crow::request first; first.body = nlohmann::json{{"name", "B"}}.dump();
+    first.add_header("if-match", readTag);
+    auto firstResp = controller->UpdateTournament(first, id);
+    ASSERT_EQ(firstResp.code, crow::NO_CONTENT);
+
+    EXPECT_CALL(*mockDelegate, UpdateTournamentIfVersion(id, _, std::vector<std::string>{"1760000000000002"}))
+        .WillOnce(Return(std::optional<std::string>{"1760000000000003"}));
+    crow::request second; second.body = nlohmann::json{{"name", "C"}}.dump();
+    second.add_header("if-match", firstResp.get_header_value("etag"));
+    auto secondResp = controller->UpdateTournament(second, id);
+    EXPECT_EQ(secondResp.code, crow::NO_CONTENT);
+    EXPECT_EQ(secondResp.get_header_value("etag"), R"("7b1d8d2f-6e40-4b47-a074-000000000042.1760000000000003-json")");
+}
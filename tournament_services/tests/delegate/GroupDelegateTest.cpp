@@ -450,10 +450,12 @@ TEST(GroupDelegateTest, RemoveGroup_GroupMissing_ReturnsError) {
 // ---- UpdateTeams: all error branches and success ----
 TEST(GroupDelegateTest, UpdateTeams_TournamentMissing_ReturnsError) {
   auto trepo = std::make_shared<StrictMock<TournamentRepositoryMock>>();
-  auto grepo = std::make_shared<NiceMock<GroupRepositoryMock>>();
-  auto teamr = std::make_shared<NiceMock<TeamRepositoryMock>>();
+  auto grepo = std::make_shared<StrictMock<GroupRepositoryMock>>();
+  auto teamr = std::make_shared<StrictMock<TeamRepositoryMock>>();
 
-  EXPECT_CALL(*trepo, ReadById("T0")).WillOnce(Return(nullptr));
+  // the tournament check is part of the AddTeams statement
+  EXPECT_CALL(*grepo, AddTeams("T0"sv,"G1"sv, std::vector<std::string>{"E1"}))
+      .WillOnce(Return(AddTeamsResult{AddTeamsStatus::TournamentNotFound, ""}));
   GroupDelegate sut{trepo, grepo, teamr};
   auto r = sut.UpdateTeams("T0","G1", std::vector<domain::Team>{{"E1","A"}});
   ASSERT_FALSE(r.has_value());
@@ -463,11 +465,10 @@ TEST(GroupDelegateTest, UpdateTeams_TournamentMissing_ReturnsError) {
 TEST(GroupDelegateTest, UpdateTeams_GroupMissing_ReturnsError) {
   auto trepo = std::make_shared<StrictMock<TournamentRepositoryMock>>();
   auto grepo = std::make_shared<StrictMock<GroupRepositoryMock>>();
-  auto teamr = std::make_shared<NiceMock<TeamRepositoryMock>>();
+  auto teamr = std::make_shared<StrictMock<TeamRepositoryMock>>();
 
-  EXPECT_CALL(*trepo, ReadById("T1")).WillOnce(Return(mkT("T1","T",1,2,domain::TournamentType::NFL)));
-  EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T1"sv,"G404"sv))
-      .WillOnce(Return(std::shared_ptr<domain::Group>{}));
+  EXPECT_CALL(*grepo, AddTeams("T1"sv,"G404"sv, std::vector<std::string>{"E1"}))
+      .WillOnce(Return(AddTeamsResult{AddTeamsStatus::GroupNotFound, ""}));
 
   GroupDelegate sut{trepo, grepo, teamr};
   auto r = sut.UpdateTeams("T1","G404", std::vector<domain::Team>{{"E1","A"}});
@@ -478,15 +479,12 @@ TEST(GroupDelegateTest, UpdateTeams_GroupMissing_ReturnsError) {
 TEST(GroupDelegateTest, UpdateTeams_ExceedsCapacity_ReturnsError) {
   auto trepo = std::make_shared<StrictMock<TournamentRepositoryMock>>();
   auto grepo = std::make_shared<StrictMock<GroupRepositoryMock>>();
-  auto teamr = std::make_shared<NiceMock<TeamRepositoryMock>>();
+  auto teamr = std::make_shared<StrictMock<TeamRepositoryMock>>();
 
-  auto t = mkT("T1","T",1,2,domain::TournamentType::NFL);
-  EXPECT_CALL(*trepo, ReadById("T1")).WillOnce(Return(t));
-  auto g = mkG("G1","A","T1"); g->Teams().push_back(domain::Team{"E0","X"}); // current = 1
-  EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T1"sv,"G1"sv)).WillOnce(Return(g));
+  EXPECT_CALL(*grepo, AddTeams("T1"sv,"G1"sv, std::vector<std::string>{"E1","E2"}))
+      .WillOnce(Return(AddTeamsResult{AddTeamsStatus::GroupFull, ""}));
 
   GroupDelegate sut{trepo, grepo, teamr};
-  // incoming = 2, total = 3 > max(2)
   auto r = sut.UpdateTeams("T1","G1", std::vector<domain::Team>{{"E1","A"},{"E2","B"}});
   ASSERT_FALSE(r.has_value());
   EXPECT_EQ(r.error(), "Group at max capacity");
@@ -495,14 +493,10 @@ TEST(GroupDelegateTest, UpdateTeams_ExceedsCapacity_ReturnsError) {
 TEST(GroupDelegateTest, UpdateTeams_DuplicateInTournament_ReturnsError) {
   auto trepo = std::make_shared<StrictMock<TournamentRepositoryMock>>();
   auto grepo = std::make_shared<StrictMock<GroupRepositoryMock>>();
-  auto teamr = std::make_shared<NiceMock<TeamRepositoryMock>>();
+  auto teamr = std::make_shared<StrictMock<TeamRepositoryMock>>();
 
-  auto t = mkT("T1","T",1,3,domain::TournamentType::NFL);
-  EXPECT_CALL(*trepo, ReadById("T1")).WillOnce(Return(t));
-  auto g = mkG("G1","A","T1"); // current = 0
-  EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T1"sv,"G1"sv)).WillOnce(Return(g));
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T1"sv,"E1"sv))
-      .WillOnce(Return(mkG("Gx","x","T1"))); // duplicate found
+  EXPECT_CALL(*grepo, AddTeams("T1"sv,"G1"sv, std::vector<std::string>{"E1"}))
+      .WillOnce(Return(AddTeamsResult{AddTeamsStatus::TeamAlreadyAssigned, "E1"}));
 
   GroupDelegate sut{trepo, grepo, teamr};
   auto r = sut.UpdateTeams("T1","G1", std::vector<domain::Team>{{"E1","A"}});
@@ -515,14 +509,8 @@ TEST(GroupDelegateTest, UpdateTeams_TeamMissing_ReturnsError) {
   auto grepo = std::make_shared<StrictMock<GroupRepositoryMock>>();
   auto teamr = std::make_shared<StrictMock<TeamRepositoryMock>>();
 
-  auto t = mkT("T1","T",1,3,domain::TournamentType::NFL);
-  EXPECT_CALL(*trepo, ReadById("T1")).WillOnce(Return(t));
-  auto g = mkG("G1","A","T1");
-  EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T1"sv,"G1"sv)).WillOnce(Return(g));
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T1"sv,"E404"sv))
-      .WillOnce(Return(nullptr));
-  EXPECT_CALL(*teamr, ReadById("E404"sv))
-      .WillOnce(Return(nullptr)); // missing
+  EXPECT_CALL(*grepo, AddTeams("T1"sv,"G1"sv, std::vector<std::string>{"E404"}))
+      .WillOnce(Return(AddTeamsResult{AddTeamsStatus::TeamNotFound, "E404"}));
 
   GroupDelegate sut{trepo, grepo, teamr};
   auto r = sut.UpdateTeams("T1","G1", std::vector<domain::Team>{{"E404","X"}});
@@ -535,21 +523,9 @@ TEST(GroupDelegateTest, UpdateTeams_Success_AddsAllTeams) {
   auto grepo = std::make_shared<StrictMock<GroupRepositoryMock>>();
   auto teamr = std::make_shared<StrictMock<TeamRepositoryMock>>();
 
-  auto t = mkT("T1","T",1,4,domain::TournamentType::NFL);
-  EXPECT_CALL(*trepo, ReadById("T1")).WillOnce(Return(t));
-  auto g = mkG("G1","A","T1");
-  EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T1"sv,"G1"sv))
-      .WillOnce(Return(g));
-  // no duplicates
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T1"sv,"E1"sv))
-      .WillOnce(Return(nullptr));
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T1"sv,"E2"sv))
-      .WillOnce(Return(nullptr));
-  // both teams exist
-  EXPECT_CALL(*teamr, ReadById("E1"sv)).WillOnce(Return(mkTeam("E1","A")));
-  EXPECT_CALL(*teamr, ReadById("E2"sv)).WillOnce(Return(mkTeam("E2","B")));
-  // both added
-  EXPECT_CALL(*grepo, UpdateGroupAddTeam("G1"sv, ::testing::_)).Times(2);
+  // both teams validated and added in one call
+  EXPECT_CALL(*grepo, AddTeams("T1"sv,"G1"sv, std::vector<std::string>{"E1","E2"}))
+      .WillOnce(Return(AddTeamsResult{AddTeamsStatus::Added, ""}));
 
   GroupDelegate sut{trepo, grepo, teamr};
   auto r = sut.UpdateTeams("T1","G1", std::vector<domain::Team>{{"E1","A"},{"E2","B"}});
@@ -53,6 +53,16 @@ TEST(TeamDelegateSpec, CreateTeam_Fails_ReturnsEmpty) {
     EXPECT_TRUE(res.empty());
 }
 
+// Caso 2b: Nombre duplicado, se consulta solo el nombre sin leer todos los equipos
+TEST(TeamDelegateSpec, TeamNameExists_AsksRepositoryByName) {
+    auto mockRepo = std::make_shared<StrictMock<MockTeamRepository>>();
+    EXPECT_CALL(*mockRepo, ExistsByName("Panthers"sv)).WillOnce(Return(true));
+
+    TeamDelegate target{mockRepo};
+
+    EXPECT_TRUE(target.TeamNameExists("Panthers"));
+}
+
 // Caso 3: Búsqueda individual exitosa
 TEST(TeamDelegateSpec, FindTeamById_ReturnsEntity) {
     auto mockRepo = std::make_shared<StrictMock<MockTeamRepository>>();
@@ -104,6 +114,22 @@ TEST(TeamDelegateSpec, FetchAll_WithTeams_ReturnsExpectedList) {
     EXPECT_EQ(res[1]->Name, "Bravo");
 }
 
+// Caso 6b: Consulta global en streaming, los equipos llegan uno por uno desde el repositorio
+TEST(TeamDelegateSpec, StreamAll_ForwardsEachTeamFromRepository) {
+    auto mockRepo = std::make_shared<StrictMock<MockTeamRepository>>();
+    EXPECT_CALL(*mockRepo, StreamAll(::testing::_))
+        .WillOnce([](const std::function<void(const domain::Team&)>& consumer) {
+            consumer(domain::Team{"A1", "Alpha"});
+            consumer(domain::Team{"B1", "Bravo"});
+        });
+
+    TeamDelegate target{mockRepo};
+    std::vector<std::string> names;
+    target.StreamAllTeams([&names](const domain::Team& team) { names.push_back(team.Name); });
+
+    EXPECT_EQ(names, (std::vector<std::string>{"Alpha", "Bravo"}));
+}
+
 // Caso 7: Actualización exitosa (conforme a la doc: ReadById -> Update)
 TEST(TeamDelegateSpec, Update_ExistingRecord_ReturnsTrue) {
     auto mockRepo = std::make_shared<StrictMock<MockTeamRepository>>();
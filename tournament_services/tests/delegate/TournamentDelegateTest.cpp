@@ -7,56 +7,35 @@
 #include "delegate/TournamentDelegate.hpp"
 #include "domain/Tournament.hpp"
 #include "persistence/repository/IRepository.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
 
 // Mock del repositorio (el que ya tienes en tests/mocks)
 #include "TournamentRepositoryMock.hpp"
 
-// ⚠️ Importante: mockeamos la CLASE CONCRETA que usa el delegate:
-#include "cms/QueueMessageProducer.hpp"
-
 using ::testing::_;
 using ::testing::Return;
 using ::testing::Throw;
-using ::testing::StrEq;
-
-// -----------------------------------------------------------------------------
-// Mock del QueueMessageProducer real.
-// Fírmalo EXACTO como en la interfaz/base (con referencias &).
-// Y llama al ctor del base con nullptr si tu base lo permite.
-// -----------------------------------------------------------------------------
-class MockQueueMessageProducer : public QueueMessageProducer {
-public:
-    MockQueueMessageProducer() : QueueMessageProducer(nullptr) {}
-
-    // Firma EXACTA: (const std::string_view&, const std::string_view&)
-    MOCK_METHOD(void, SendMessage,
-                (const std::string_view& message, const std::string_view& queue),
-                (override));
-};
 
 class TournamentDelegateTest : public ::testing::Test {
 protected:
     std::shared_ptr<MockTournamentRepository> repo;
-    std::shared_ptr<MockQueueMessageProducer> mockProducer; // para EXPECT_CALL
     std::shared_ptr<TournamentDelegate>       delegate;
 
     void SetUp() override {
         repo         = std::make_shared<MockTournamentRepository>();
-        mockProducer = std::make_shared<MockQueueMessageProducer>();
-        // Se convierte implícitamente a std::shared_ptr<QueueMessageProducer>
-        delegate     = std::make_shared<TournamentDelegate>(repo, mockProducer);
+        // los eventos los escribe el repositorio en el outbox, el delegate ya no usa el broker
+        delegate     = std::make_shared<TournamentDelegate>(repo);
     }
 };
 
-// Crear OK -> regresa ID y envía evento
-TEST_F(TournamentDelegateTest, CreateTournament_Valid_SendsMessageAndReturnsId) {
+// Crear OK -> regresa ID (el evento queda en el outbox dentro del repositorio)
+TEST_F(TournamentDelegateTest, CreateTournament_Valid_ReturnsId) {
     auto t = std::make_shared<domain::Tournament>(
         "Torneo X",
         domain::TournamentFormat(2, 8, domain::TournamentType::ROUND_ROBIN)
     );
 
     EXPECT_CALL(*repo, Create(_)).WillOnce(Return("gen-id-1"));
-    EXPECT_CALL(*mockProducer, SendMessage(StrEq("gen-id-1"), StrEq("tournament.created"))).Times(1);
 
     auto id = delegate->CreateTournament(t);
     EXPECT_EQ(id, "gen-id-1");
@@ -117,14 +96,21 @@ TEST_F(TournamentDelegateTest, ReadAll_EmptyList) {
     EXPECT_TRUE(list.empty());
 }
 
-// Update OK: llama repo y emite evento
-TEST_F(TournamentDelegateTest, UpdateTournament_Ok_CallsRepoAndSendsEvent) {
+// Update OK: llama repo y regresa la nueva versión
+TEST_F(TournamentDelegateTest, UpdateTournament_Ok_ReturnsNewVersion) {
     auto t = std::make_shared<domain::Tournament>("Nuevo Nombre");
     t->Id() = "id-999";
 
-    EXPECT_CALL(*repo, Update(_)).WillOnce(Return("id-999"));
-    EXPECT_CALL(*mockProducer, SendMessage(StrEq("id-999"), StrEq("tournament.updated"))).Times(1);
+    EXPECT_CALL(*repo, UpdateReturningVersion(_)).WillOnce(Return("1760000000000002"));
+
+    EXPECT_EQ(delegate->UpdateTournament("id-999", t), "1760000000000002");
+}
+
+// Crear sin conexiones disponibles -> se propaga para que el controller responda 503
+TEST_F(TournamentDelegateTest, CreateTournament_PoolExhausted_Propagates) {
+    auto t = std::make_shared<domain::Tournament>("Torneo Y");
+
+    EXPECT_CALL(*repo, Create(_)).WillOnce(Throw(ConnectionPoolExhausted("no database connection available")));
 
-    delegate->UpdateTournament("id-999", t);
-    SUCCEED();
+    EXPECT_THROW(delegate->CreateTournament(t), ConnectionPoolExhausted);
 }
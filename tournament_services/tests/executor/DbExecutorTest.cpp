@@ -0,0 +1,62 @@
+//
+// Cola acotada del DbExecutor
+//
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <latch>
+
+#include "executor/DbExecutor.hpp"
+
+// Caso 1: Con el hilo ocupado y la cola llena, Submit rechaza y no ejecuta la tarea
+TEST(DbExecutorTest, Submit_QueueFull_Refuses) {
+    std::latch release{1};
+    std::atomic<int> ran{0};
+    std::promise<void> started;
+    {
+        DbExecutor executor{1, 2};
+        ASSERT_TRUE(executor.Submit([&] { started.set_value(); release.wait(); ran++; }));
+        started.get_future().wait();
+
+        EXPECT_TRUE(executor.Submit([&] { ran++; }));
+        EXPECT_TRUE(executor.Submit([&] { ran++; }));
+        EXPECT_FALSE(executor.Submit([&] { ran += 100; }));
+
+        release.count_down();
+    }
+    // las tareas aceptadas corren antes de que el executor termine, la rechazada nunca
+    EXPECT_EQ(ran.load(), 3);
+}
+
+// Caso 2: Al vaciarse la cola vuelve a aceptar trabajo
+TEST(DbExecutorTest, Submit_AcceptsAgainAfterDraining) {
+    DbExecutor executor{2, 1};
+    std::promise<void> done;
+    ASSERT_TRUE(executor.Submit([&] { done.set_value(); }));
+    done.get_future().wait();
+
+    std::promise<void> again;
+    EXPECT_TRUE(executor.Submit([&] { again.set_value(); }));
+    again.get_future().wait();
+    EXPECT_EQ(executor.ThreadCount(), 2u);
+}
+
+// Caso 3: Shutdown corre lo encolado, espera a los hilos y luego rechaza trabajo nuevo
+TEST(DbExecutorTest, Shutdown_RunsQueuedTasksThenRefuses) {
+    std::atomic<int> ran{0};
+    std::latch release{1};
+    DbExecutor executor{1, 4};
+    ASSERT_TRUE(executor.Submit([&] { release.wait(); ran++; }));
+    ASSERT_TRUE(executor.Submit([&] { ran++; }));
+    ASSERT_TRUE(executor.Submit([&] { ran++; }));
+
+    auto shutdown = std::async(std::launch::async, [&] { executor.Shutdown(); });
+    release.count_down();
+    shutdown.get();
+
+    // al volver Shutdown ya corrieron todas las aceptadas
+    EXPECT_EQ(ran.load(), 3);
+    EXPECT_FALSE(executor.Submit([&] { ran += 100; }));
+    EXPECT_EQ(ran.load(), 3);
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <gmock/gmock.h>
+#include <string>
+
+#include "cms/IBatchSender.hpp"
+
+class BatchSenderMock : public IBatchSender {
+public:
+    MOCK_METHOD(void, Send, (const std::string&, const std::string&), (override));
+    MOCK_METHOD(void, Commit, (), (override));
+    MOCK_METHOD(void, Reset, (), (override));
+};
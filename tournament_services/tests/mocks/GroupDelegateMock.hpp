@@ -1,6 +1,7 @@
 #pragma once
 #include <gmock/gmock.h>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -30,6 +31,12 @@ public:
                 (const std::string_view& tournamentId),
                 (override));
 
+    // GetGroups paginado: una página de grupos y el cursor de la siguiente
+    MOCK_METHOD((std::expected<Page<domain::Group>, std::string>),
+                GetGroups,
+                (const std::string_view& tournamentId, const PageRequest& page),
+                (override));
+
     // GetGroup: retorna un grupo específico o error
     MOCK_METHOD((std::expected<std::shared_ptr<domain::Group>, std::string>),
                 GetGroup,
@@ -42,6 +49,18 @@ public:
                 (const std::string_view& tournamentId, const domain::Group& group),
                 (override));
 
+    // UpdateGroupIfVersion: actualiza solo si el grupo sigue en una de las versiones (If-Match)
+    MOCK_METHOD((std::expected<std::optional<std::string>, std::string>),
+                UpdateGroupIfVersion,
+                (const std::string_view& tournamentId, const domain::Group& group, const std::vector<std::string>& versions),
+                (override));
+
+    // GetGroupVersion: version del grupo para GET condicional, vacia si no existe
+    MOCK_METHOD(std::string,
+                GetGroupVersion,
+                (const std::string_view& tournamentId, const std::string_view& groupId),
+                (override));
+
     // RemoveGroup: elimina un grupo, retorna void o error
     MOCK_METHOD((std::expected<void, std::string>),
                 RemoveGroup,
@@ -20,6 +20,9 @@ public:
 
     MOCK_METHOD(std::vector<std::shared_ptr<domain::Group>>, FindByTournamentId,
                 (const std::string_view&), (override));
+    MOCK_METHOD(Page<domain::Group>, ReadPage, (const PageRequest&), (override));
+    MOCK_METHOD(Page<domain::Group>, FindByTournamentId,
+                (const std::string_view&, const PageRequest&), (override));
     MOCK_METHOD(std::shared_ptr<domain::Group>, FindByTournamentIdAndGroupId,
                 (const std::string_view&, const std::string_view&), (override));
     MOCK_METHOD(std::shared_ptr<domain::Group>, FindByTournamentIdAndTeamId,
@@ -27,4 +30,7 @@ public:
 
     MOCK_METHOD(void, UpdateGroupAddTeam,
                 (const std::string_view&, const std::shared_ptr<domain::Team>&), (override));
+    MOCK_METHOD(AddTeamsResult, AddTeams,
+                (const std::string_view&, const std::string_view&, const std::vector<std::string>&), (override));
+    MOCK_METHOD(size_t, CountTeams, (const std::string_view&), (override));
 };
\ No newline at end of file
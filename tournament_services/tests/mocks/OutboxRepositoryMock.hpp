@@ -0,0 +1,14 @@
+#pragma once
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "persistence/repository/IOutboxRepository.hpp"
+
+class OutboxRepositoryMock : public IOutboxRepository {
+public:
+    MOCK_METHOD(std::vector<OutboxEvent>, Claim, (size_t, std::chrono::milliseconds), (override));
+    MOCK_METHOD(void, Delete, (const std::vector<int64_t>&), (override));
+    MOCK_METHOD(void, Release, (const std::vector<int64_t>&), (override));
+};
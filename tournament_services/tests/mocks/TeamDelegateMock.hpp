@@ -11,7 +11,10 @@ class TeamDelegateMock : public ITeamDelegate {
 public:
 
     MOCK_METHOD(std::vector<std::shared_ptr<domain::Team>>, GetAllTeams, (), (override));
+    MOCK_METHOD(Page<domain::Team>, GetTeamsPage, (const PageRequest&), (override));
+    MOCK_METHOD(bool, TeamNameExists, (std::string_view), (override));
     MOCK_METHOD(std::string_view, SaveTeam, (const domain::Team&), (override));
+    MOCK_METHOD(std::vector<TeamImportResult>, SaveTeams, (const std::vector<domain::Team>&), (override));
     MOCK_METHOD(std::shared_ptr<domain::Team>, GetTeam, (std::string_view), (override));
     MOCK_METHOD(void, UpdateTeam, (std::string_view, const domain::Team&), (override));
     MOCK_METHOD(void, DeleteTeam, (std::string_view), (override));
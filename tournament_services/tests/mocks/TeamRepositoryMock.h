@@ -1,5 +1,6 @@
 #pragma once
 #include <gmock/gmock.h>
+#include <functional>
 #include <memory>
 #include <string_view>
 #include <string>
@@ -16,8 +17,13 @@ public:
 
     MOCK_METHOD(std::string_view, Create, (const domain::Team&), (override));
     MOCK_METHOD(std::vector<std::shared_ptr<domain::Team>>, ReadAll, (), (override));
+    MOCK_METHOD(Page<domain::Team>, ReadPage, (const PageRequest&), (override));
     MOCK_METHOD(std::shared_ptr<domain::Team>, ReadById, (std::string_view), (override));
+    MOCK_METHOD(std::vector<std::shared_ptr<domain::Team>>, ReadByIds, (const std::vector<std::string>&), (override));
     MOCK_METHOD(std::string_view, Update, (const domain::Team&), (override));
     MOCK_METHOD(void, Delete, (std::string_view), (override));
+    MOCK_METHOD(std::vector<TeamImportResult>, CreateMany, (const std::vector<domain::Team>&), (override));
+    MOCK_METHOD(bool, ExistsByName, (std::string_view), (override));
+    MOCK_METHOD(void, StreamAll, (const std::function<void(const domain::Team&)>&), (override));
 };
 using MockTeamRepository = TeamRepositoryMock;
\ No newline at end of file
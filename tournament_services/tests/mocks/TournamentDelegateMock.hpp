@@ -1,6 +1,7 @@
 #pragma once
 #include <gmock/gmock.h>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -12,8 +13,12 @@ class TournamentDelegateMock : public ITournamentDelegate {
 public:
     MOCK_METHOD(std::string, CreateTournament, (std::shared_ptr<domain::Tournament>), (override));
     MOCK_METHOD(std::vector<std::shared_ptr<domain::Tournament>>, ReadAll, (), (override));
-    // GET por id: agrega este metodo si existe en tu interfaz real
-    MOCK_METHOD(std::shared_ptr<domain::Tournament>, ReadById, (const std::string&), ());
-    MOCK_METHOD(void, UpdateTournament, (const std::string&, std::shared_ptr<domain::Tournament>), (override));
+    MOCK_METHOD(Page<domain::Tournament>, ReadPage, (const PageRequest&), (override));
+    MOCK_METHOD(std::shared_ptr<domain::Tournament>, ReadById, (const std::string&), (override));
+    MOCK_METHOD(std::string, UpdateTournament, (const std::string&, std::shared_ptr<domain::Tournament>), (override));
     MOCK_METHOD(void, DeleteTournament, (const std::string&), (override));
+    MOCK_METHOD(std::optional<std::string>, UpdateTournamentIfVersion,
+                (const std::string&, std::shared_ptr<domain::Tournament>, const std::vector<std::string>&), (override));
+    MOCK_METHOD(std::string, TournamentVersion, (const std::string&), (override));
+    MOCK_METHOD(std::string, CollectionVersion, (), (override));
 };
@@ -12,7 +12,13 @@ class MockTournamentRepository : public IRepository<domain::Tournament, std::str
 public:
     MOCK_METHOD(std::string, Create, (const domain::Tournament&), (override));
     MOCK_METHOD(std::vector<std::shared_ptr<domain::Tournament>>, ReadAll, (), (override));
+    MOCK_METHOD(Page<domain::Tournament>, ReadPage, (const PageRequest&), (override));
     MOCK_METHOD(std::shared_ptr<domain::Tournament>, ReadById, (std::string), (override));
     MOCK_METHOD(std::string, Update, (const domain::Tournament&), (override));
     MOCK_METHOD(void, Delete, (std::string), (override));
+    MOCK_METHOD(std::string, UpdateReturningVersion, (const domain::Tournament&), (override));
+    MOCK_METHOD(std::string, Version, (std::string), (override));
+    MOCK_METHOD(std::string, CollectionVersion, (), (override));
+    MOCK_METHOD(std::optional<std::string>, UpdateIfVersion,
+                (const domain::Tournament&, const std::vector<std::string>&), (override));
 };
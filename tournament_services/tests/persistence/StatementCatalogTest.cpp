@@ -0,0 +1,80 @@
+//
+// Sentencias del catálogo que escriben en el outbox
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <bitset>
+#include <string>
+
+#include "persistence/configuration/StatementCatalog.hpp"
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+namespace {
+    // el evento se escribe en la misma sentencia que el cambio, con el id que devuelve
+    void ExpectOutboxEvent(const statements::Statement& statement, const std::string& changed, const std::string& queue) {
+        const std::string sql = statement.sql;
+        EXPECT_THAT(sql, HasSubstr(changed + " as ("));
+        EXPECT_THAT(sql, HasSubstr("insert into OUTBOX (queue, payload) select '" + queue + "', id::text from " + changed));
+        EXPECT_THAT(sql, ::testing::ContainsRegex("select id(, [a-z]+)* from " + changed));
+    }
+}
+
+// Caso 1: Crear un torneo encola tournament.created
+TEST(StatementCatalogTest, InsertTournament_QueuesCreatedEvent) {
+    ExpectOutboxEvent(statements::InsertTournament, "inserted", "tournament.created");
+    EXPECT_THAT(std::string{statements::InsertTournament.sql}, HasSubstr("insert into TOURNAMENTS"));
+}
+
+// Caso 2: Actualizar un torneo encola tournament.updated solo si existía
+TEST(StatementCatalogTest, UpdateTournament_QueuesUpdatedEvent) {
+    ExpectOutboxEvent(statements::UpdateTournament, "updated", "tournament.updated");
+    EXPECT_THAT(std::string{statements::UpdateTournament.sql}, HasSubstr("update tournaments"));
+    // el PUT sin If-Match también devuelve el etag de la nueva versión
+    EXPECT_THAT(std::string{statements::UpdateTournament.sql}, HasSubstr("select id, version from updated"));
+}
+
+// Caso 3: Borrar un torneo encola tournament.deleted solo si existía
+TEST(StatementCatalogTest, DeleteTournament_QueuesDeletedEvent) {
+    ExpectOutboxEvent(statements::DeleteTournament, "deleted", "tournament.deleted");
+    EXPECT_THAT(std::string{statements::DeleteTournament.sql}, HasSubstr("delete from tournaments"));
+}
+
+// Caso 4: La actualización condicionada solo encola si escribió
+TEST(StatementCatalogTest, UpdateTournamentIfVersion_QueuesUpdatedEvent) {
+    EXPECT_THAT(std::string{statements::UpdateTournamentIfVersion.sql},
+                HasSubstr("insert into OUTBOX (queue, payload) select 'tournament.updated', id::text from updated"));
+}
+
+// Caso 5: La reserva del relay es una marca con caducidad, no un borrado bajo bloqueo
+TEST(StatementCatalogTest, ClaimOutboxEvents_LeasesInsteadOfDeleting) {
+    const std::string sql = statements::ClaimOutboxEvents.sql;
+    EXPECT_THAT(sql, HasSubstr("update OUTBOX set claimed_until"));
+    EXPECT_THAT(sql, HasSubstr("claimed_until is null or claimed_until < now()"));
+    EXPECT_THAT(sql, HasSubstr("for update skip locked"));
+    EXPECT_THAT(sql, Not(HasSubstr("delete")));
+}
+
+// Caso 6: Cada sentencia tiene su propio índice y no queda ninguno sin usar
+TEST(StatementCatalogTest, Indexes_UniqueAndInRange) {
+    const statements::Statement all[] = {
+        statements::InsertTournament, statements::SelectTournamentById, statements::InsertTeam,
+        statements::SelectTeamById, statements::TeamNameExists, statements::DeleteTeam,
+        statements::InsertGroup, statements::SelectGroupsByTournament, statements::SelectGroupInTournament,
+        statements::SelectGroupByTournamentIdGroupId, statements::UpdateGroupAddTeam, statements::AddTeamsToGroup,
+        statements::SelectTeamsPage, statements::SelectTournamentsPage, statements::SelectGroupsByTournamentPage,
+        statements::SelectTournamentsVersion, statements::UpdateTournamentIfVersion, statements::SelectGroupVersion,
+        statements::SelectTournamentVersion, statements::CountTeamsInTournament,
+        statements::UpdateGroupIfVersion, statements::UpdateTournament, statements::DeleteTournament,
+        statements::ClaimOutboxEvents, statements::DeleteOutboxEvents, statements::ReleaseOutboxEvents,
+    };
+    std::bitset<statements::Count> seen;
+    for (const auto& statement : all) {
+        ASSERT_LT(statement.index, statements::Count) << statement.name;
+        EXPECT_FALSE(seen.test(statement.index)) << statement.name;
+        seen.set(statement.index);
+    }
+    EXPECT_TRUE(seen.all());
+}